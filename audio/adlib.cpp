@@ -937,6 +937,7 @@ public:
 	void close() override;
 	void send(uint32 b) override;
 	void send(int8 channel, uint32 b) override; // Supports higher than channel 15
+	void onTrackStart() override;
 	uint32 property(int prop, uint32 param) override;
 	bool isOpen() const override { return _isOpen; }
 	uint32 getBaseTempo() override { return 1000000 / OPL::OPL::kDefaultCallbackFrequency; }
@@ -1488,6 +1489,13 @@ void MidiDriver_ADLIB::send(uint32 b) {
 	send(b & 0xF, b & 0xFFFFFFF0);
 }
 
+void MidiDriver_ADLIB::onTrackStart() {
+	// Restart the modulation timer, so that a track always sounds the same
+	// from its start and the OPL can cache it
+	if (_opl && _opl->startTrack())
+		_timerCounter = 0;
+}
+
 void MidiDriver_ADLIB::send(int8 chan, uint32 b) {
 	//byte param3 = (byte) ((b >> 24) & 0xFF);
 	byte param2 = (byte)((b >> 16) & 0xFF);
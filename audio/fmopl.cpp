@@ -23,11 +23,14 @@
 #include "audio/fmopl.h"
 
 #include "audio/mixer.h"
+#include "audio/renderahead.h"
+#include "audio/rendercache.h"
 #include "audio/softsynth/opl/dosbox.h"
 #include "audio/softsynth/opl/mame.h"
 #include "audio/softsynth/opl/nuked.h"
 
 #include "common/config-manager.h"
+#include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/timer.h"
@@ -233,6 +236,174 @@ OPL *Config::create(DriverId driver, OplType type) {
 	}
 }
 
+bool Config::loadRegisterLog(Common::SeekableReadStream &stream, RegisterLog &log, OplType &type) {
+	char signature[8];
+	if (stream.read(signature, 8) != 8 || memcmp(signature, "DBRAWOPL", 8))
+		return false;
+
+	const uint16 versionMajor = stream.readUint16LE();
+	stream.skip(2);
+	if (versionMajor != 2) {
+		warning("Unsupported DRO version %d", versionMajor);
+		return false;
+	}
+
+	const uint32 numPairs = stream.readUint32LE();
+	stream.skip(4);
+	const byte hardwareType = stream.readByte();
+	const byte format = stream.readByte();
+	const byte compression = stream.readByte();
+	const byte shortDelayCode = stream.readByte();
+	const byte longDelayCode = stream.readByte();
+	const byte codemapLength = stream.readByte();
+
+	if (hardwareType > kOpl3 || format != 0 || compression != 0 || codemapLength > 128)
+		return false;
+
+	byte codemap[128];
+	if (stream.read(codemap, codemapLength) != codemapLength)
+		return false;
+
+	type = (OplType)hardwareType;
+	log.clear();
+
+	uint32 delay = 0;
+	for (uint32 i = 0; i < numPairs; ++i) {
+		const byte index = stream.readByte();
+		const byte value = stream.readByte();
+		if (stream.eos() || stream.err())
+			return false;
+
+		if (index == shortDelayCode) {
+			delay += value + 1;
+		} else if (index == longDelayCode) {
+			delay += (value + 1) << 8;
+		} else if ((index & 0x7f) < codemapLength) {
+			RegisterLogEntry entry;
+			entry.delay = delay;
+			entry.reg = codemap[index & 0x7f] | ((index & 0x80) << 1);
+			entry.value = value;
+			log.push_back(entry);
+			delay = 0;
+		}
+	}
+
+	return !log.empty();
+}
+
+static void addLogEntry(RegisterLog &log, uint32 &delay, int reg, int value) {
+	RegisterLogEntry entry;
+	entry.delay = delay;
+	entry.reg = reg;
+	entry.value = value;
+	log.push_back(entry);
+	delay = 0;
+}
+
+void Config::createTestRegisterLog(OplType type, uint32 milliseconds, RegisterLog &log) {
+	const int channels = (type == kOpl3) ? 18 : 9;
+	static const byte slotOffsets[9] = { 0, 1, 2, 8, 9, 10, 16, 17, 18 };
+
+	uint32 delay = 0;
+	log.clear();
+
+	if (type == kOpl3)
+		addLogEntry(log, delay, 0x105, 1);
+	addLogEntry(log, delay, 0x01, 0x20);
+
+	uint32 seed = 1;
+	for (uint32 time = 0; time < milliseconds; time += 4) {
+		seed = seed * 1103515245 + 12345;
+		const int channel = (seed >> 16) % channels;
+		const int bank = (channel >= 9) ? 0x100 : 0;
+		const int op = slotOffsets[channel % 9];
+
+		if (seed & 0x80000000) {
+			// Program a patch and play a note
+			for (int i = 0; i < 2; ++i) {
+				const int slot = bank | (op + i * 3);
+				addLogEntry(log, delay, 0x20 + slot, 0x21);
+				addLogEntry(log, delay, 0x40 + slot, i ? 0x00 : 0x10 + ((seed >> 8) & 0x0f));
+				addLogEntry(log, delay, 0x60 + slot, 0xf2);
+				addLogEntry(log, delay, 0x80 + slot, 0x54);
+				addLogEntry(log, delay, 0xe0 + slot, (seed >> (4 + i)) & 0x03);
+			}
+			addLogEntry(log, delay, bank | (0xc0 + channel % 9), 0x30 | ((seed >> 12) & 0x0e));
+			addLogEntry(log, delay, bank | (0xa0 + channel % 9), seed & 0xff);
+			addLogEntry(log, delay, bank | (0xb0 + channel % 9), 0x20 | ((seed >> 24) & 0x1f));
+		} else if (seed & 0x40000000) {
+			addLogEntry(log, delay, bank | (0xb0 + channel % 9), (seed >> 24) & 0x1f);
+		}
+
+		// The next tick
+		delay += 4;
+	}
+
+	// A harmless write so that the final ticks are rendered as well
+	addLogEntry(log, delay, 0x01, 0x20);
+}
+
+int32 Config::benchmark(DriverId driver, OplType type, const RegisterLog &log, uint32 &numSamples) {
+	switch (driver) {
+	case kMame:
+	case kDOSBox:
+	case kNuked:
+		break;
+	default:
+		return -1;
+	}
+
+	EmulatedOPL *opl = (EmulatedOPL *)create(driver, type);
+	if (!opl)
+		return -1;
+
+	if (!opl->init()) {
+		delete opl;
+		return -1;
+	}
+
+	// The samples are generated directly, there is no timer callback
+	// and nothing is being mixed
+	const uint32 rate = opl->getRate();
+	const int stereoFactor = opl->isStereo() ? 2 : 1;
+	const uint32 chunkSize = 512;
+	int16 *buffer = new int16[chunkSize * stereoFactor];
+	uint32 time = 0;
+	numSamples = 0;
+
+	const uint32 start = g_system->getMillis();
+
+	for (uint i = 0; i < log.size(); ++i) {
+		const RegisterLogEntry &entry = log[i];
+
+		if (entry.delay) {
+			time += entry.delay;
+			const uint32 target = (uint64)time * rate / 1000;
+			while (numSamples < target) {
+				const uint32 samples = MIN(chunkSize, target - numSamples);
+				opl->generateSamples(buffer, samples * stereoFactor);
+				numSamples += samples;
+			}
+		}
+
+		if (!(entry.reg & 0x100)) {
+			opl->writeReg(entry.reg, entry.value);
+		} else if (type == kOpl3) {
+			opl->writeReg(entry.reg, entry.value);
+		} else if (type == kDualOpl2) {
+			// Address the second chip through its own ports
+			opl->write(0x222, entry.reg & 0xff);
+			opl->write(0x223, entry.value);
+		}
+	}
+
+	const int32 elapsed = g_system->getMillis() - start;
+
+	delete[] buffer;
+	delete opl;
+	return elapsed;
+}
+
 void OPL::start(TimerCallback *callback, int timerFrequency) {
 	_callback.reset(callback);
 	startCallbacks(timerFrequency);
@@ -306,7 +477,11 @@ EmulatedOPL::EmulatedOPL() :
 	_nextTick(0),
 	_samplesPerTick(0),
 	_baseFreq(0),
-	_handle(new Audio::SoundHandle()) {
+	_handle(new Audio::SoundHandle()),
+	_renderAhead(nullptr),
+	_renderCache(nullptr),
+	_cacheAddress(0) {
+	memset(_cacheRegisters, 0, sizeof(_cacheRegisters));
 }
 
 EmulatedOPL::~EmulatedOPL() {
@@ -320,6 +495,49 @@ EmulatedOPL::~EmulatedOPL() {
 }
 
 int EmulatedOPL::readBuffer(int16 *buffer, const int numSamples) {
+	if (_renderAhead)
+		return _renderAhead->readBuffer(buffer, numSamples);
+
+	renderSamples(buffer, numSamples);
+	return numSamples;
+}
+
+uint32 EmulatedOPL::getRenderAheadUnderruns() const {
+	return _renderAhead ? _renderAhead->getUnderruns() : 0;
+}
+
+bool EmulatedOPL::startTrack() {
+	if (!_renderCache)
+		return false;
+
+	_renderCache->startTrack(Audio::RenderCache::hash(_cacheRegisters, sizeof(_cacheRegisters)));
+	return true;
+}
+
+void EmulatedOPL::cacheWrite(int port, int val) {
+	if (!_renderCache)
+		return;
+
+	if (port & 1)
+		_cacheRegisters[_cacheAddress] = val;
+	else
+		_cacheAddress = (val & 0xff) | ((port & 2) << 7);
+	_renderCache->input(0x40000000 | ((port & 0xffff) << 8) | (val & 0xff));
+}
+
+void EmulatedOPL::cacheWriteReg(int r, int v) {
+	if (!_renderCache)
+		return;
+
+	_cacheRegisters[r & 0x1ff] = v;
+	_renderCache->input(0x80000000 | ((r & 0x1ff) << 8) | (v & 0xff));
+}
+
+void EmulatedOPL::renderAheadProc(void *refCon, int16 *buffer, int numSamples) {
+	((EmulatedOPL *)refCon)->renderSamples(buffer, numSamples);
+}
+
+void EmulatedOPL::renderSamples(int16 *buffer, int numSamples) {
 	const int stereoFactor = isStereo() ? 2 : 1;
 	int len = numSamples / stereoFactor;
 	int step;
@@ -329,10 +547,21 @@ int EmulatedOPL::readBuffer(int16 *buffer, const int numSamples) {
 		if (step > (_nextTick >> FIXP_SHIFT))
 			step = (_nextTick >> FIXP_SHIFT);
 
+		// The chip is clocked even while music is played from the render
+		// cache, so that its envelopes are right when playback falls back to
+		// live synthesis. The cached samples replace the generated ones.
 		generateSamples(buffer, step * stereoFactor);
+		if (_renderCache) {
+			const int cached = _renderCache->readSamples(buffer, step);
+			if (cached < step)
+				_renderCache->addSamples(buffer + cached * stereoFactor, step - cached);
+		}
 
 		_nextTick -= step << FIXP_SHIFT;
 		if (!(_nextTick >> FIXP_SHIFT)) {
+			if (_renderCache)
+				_renderCache->tick();
+
 			if (_callback && _callback->isValid())
 				(*_callback)();
 
@@ -342,8 +571,6 @@ int EmulatedOPL::readBuffer(int16 *buffer, const int numSamples) {
 		buffer += step * stereoFactor;
 		len -= step;
 	} while (len);
-
-	return numSamples;
 }
 
 int EmulatedOPL::getRate() const {
@@ -352,11 +579,25 @@ int EmulatedOPL::getRate() const {
 
 void EmulatedOPL::startCallbacks(int timerFrequency) {
 	setCallbackFrequency(timerFrequency);
+
+	const uint latency = Audio::RenderAheadBuffer::getConfiguredLatency();
+	if (latency && !_renderAhead)
+		_renderAhead = new Audio::RenderAheadBuffer(&renderAheadProc, this, getRate(), isStereo(), latency);
+
+	if (Audio::RenderCache::isEnabled() && !_renderCache)
+		_renderCache = new Audio::RenderCache("opl-" + ConfMan.get("opl_driver"), getRate(), isStereo());
+
 	g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 }
 
 void EmulatedOPL::stopCallbacks() {
 	g_system->getMixer()->stopHandle(*_handle);
+
+	delete _renderAhead;
+	_renderAhead = nullptr;
+
+	delete _renderCache;
+	_renderCache = nullptr;
 }
 
 void EmulatedOPL::setCallbackFrequency(int timerFrequency) {
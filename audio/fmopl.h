@@ -25,15 +25,19 @@
 
 #include "audio/audiostream.h"
 
+#include "common/array.h"
 #include "common/func.h"
 #include "common/ptr.h"
 #include "common/scummsys.h"
 
 namespace Audio {
+class RenderAheadBuffer;
+class RenderCache;
 class SoundHandle;
 }
 
 namespace Common {
+class SeekableReadStream;
 class String;
 }
 
@@ -41,6 +45,17 @@ namespace OPL {
 
 class OPL;
 
+/**
+ * A register write in a captured OPL register log.
+ */
+struct RegisterLogEntry {
+	uint32 delay;	///< Milliseconds of output before the write
+	uint16 reg;		///< Register, bit 8 selects the second OPL3 bank or OPL2 chip
+	byte value;
+};
+
+typedef Common::Array<RegisterLogEntry> RegisterLog;
+
 class Config {
 public:
 	enum OplFlags {
@@ -102,6 +117,36 @@ public:
 	 */
 	static OPL *create(OplType type = kOpl2);
 
+	/**
+	 * Loads a register log captured by DOSBox (a version 2 .dro file).
+	 *
+	 * @param stream	stream to read the log from
+	 * @param log		receives the register writes
+	 * @param type		receives the OPL type the log was captured from
+	 * @return true on success
+	 */
+	static bool loadRegisterLog(Common::SeekableReadStream &stream, RegisterLog &log, OplType &type);
+
+	/**
+	 * Creates the register log of a synthetic AdLib style tune, which plays
+	 * random notes at a 250Hz tick rate like a typical AdLib music driver.
+	 */
+	static void createTestRegisterLog(OplType type, uint32 milliseconds, RegisterLog &log);
+
+	/**
+	 * Replays a register log with an emulated OPL and measures how long
+	 * rendering it takes. This must not be called while another OPL instance
+	 * exists.
+	 *
+	 * @param driver		emulator to measure
+	 * @param type			OPL type to emulate
+	 * @param log			register writes to replay
+	 * @param numSamples	receives the number of sample frames rendered
+	 * @return the time spent in milliseconds, or -1 if the driver is not
+	 *         an emulator or could not be created
+	 */
+	static int32 benchmark(DriverId driver, OplType type, const RegisterLog &log, uint32 &numSamples);
+
 private:
 	static const EmulatorDescription _drivers[];
 };
@@ -121,6 +166,11 @@ public:
 	OPL();
 	virtual ~OPL() { _hasInstance = false; }
 
+	/**
+	 * Whether an OPL instance currently exists. Only one can exist at a time.
+	 */
+	static bool hasInstance() { return _hasInstance; }
+
 	/**
 	 * Initializes the OPL emulator.
 	 *
@@ -176,6 +226,15 @@ public:
 	 */
 	virtual void setCallbackFrequency(int timerFrequency) = 0;
 
+	/**
+	 * Notify the OPL that a piece of music starts playing from the beginning
+	 * with the next callback. Emulated OPLs use this to cache the rendered
+	 * music when the "music_render_cache" setting is enabled.
+	 *
+	 * @return whether the music is being cached
+	 */
+	virtual bool startTrack() { return false; }
+
 	enum {
 		/**
 		 * The default callback frequency that start() uses
@@ -238,18 +297,27 @@ private:
  * decoded in readBuffer().
  */
 class EmulatedOPL : public OPL, protected Audio::AudioStream {
+	friend class Config;
+
 public:
 	EmulatedOPL();
 	virtual ~EmulatedOPL();
 
 	// OPL API
 	void setCallbackFrequency(int timerFrequency);
+	bool startTrack();
 
 	// AudioStream API
 	int readBuffer(int16 *buffer, const int numSamples);
 	int getRate() const;
 	bool endOfData() const { return false; }
 
+	/**
+	 * Number of times rendering ahead couldn't keep up with the mixer.
+	 * Always 0 unless render-ahead is enabled.
+	 */
+	uint32 getRenderAheadUnderruns() const;
+
 protected:
 	// OPL API
 	void startCallbacks(int timerFrequency);
@@ -267,7 +335,20 @@ protected:
 	 */
 	virtual void generateSamples(int16 *buffer, int numSamples) = 0;
 
+	/**
+	 * Report writes to the render cache. Subclasses call these from
+	 * write() and writeReg().
+	 */
+	void cacheWrite(int port, int val);
+	void cacheWriteReg(int r, int v);
+
 private:
+	/**
+	 * Generate samples, calling the timer callback at the right points.
+	 */
+	void renderSamples(int16 *buffer, int numSamples);
+	static void renderAheadProc(void *refCon, int16 *buffer, int numSamples);
+
 	int _baseFreq;
 
 	enum {
@@ -278,6 +359,13 @@ private:
 	int _samplesPerTick;
 
 	Audio::SoundHandle *_handle;
+	Audio::RenderAheadBuffer *_renderAhead;
+
+	Audio::RenderCache *_renderCache;
+
+	/** The registers as far as the render cache is concerned, which identify the chip state. */
+	byte _cacheRegisters[0x200];
+	int _cacheAddress;
 };
 
 } // End of namespace OPL
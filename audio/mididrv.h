@@ -187,6 +187,14 @@ public:
 	 */
 	virtual bool isReady() { return true; }
 
+	/**
+	 * Called by the MIDI parser when it starts playing a track from the
+	 * beginning, including when it loops. The first events of the track
+	 * follow with the next timer callback. Drivers which cache their
+	 * rendered output use this to tell tracks apart.
+	 */
+	virtual void onTrackStart() { }
+
 protected:
 
 	/**
@@ -385,6 +385,8 @@ bool MidiParser::setTrack(int track) {
 	_activeTrack = track;
 	_position._playPos = _tracks[track];
 	parseNextEvent(_nextEvent);
+	if (_driver && _doParse)
+		_driver->onTrackStart();
 	return true;
 }
 
@@ -402,6 +404,8 @@ bool MidiParser::startPlaying() {
 		_position._playPos = _tracks[_activeTrack];
 		parseNextEvent(_nextEvent);
 	}
+	if (_driver && !_doParse && !_position._playTick)
+		_driver->onTrackStart();
 	_doParse = true;
 	return true;
 }
@@ -466,6 +470,8 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 	resetTracking();
 	_position._playPos = _tracks[_activeTrack];
 	parseNextEvent(_nextEvent);
+	if (tick == 0 && _driver && _doParse)
+		_driver->onTrackStart();
 	if (tick > 0) {
 		while (true) {
 			EventInfo &info = _nextEvent;
@@ -134,6 +134,11 @@ void MidiPlayer::metaEvent(byte type, byte *data, uint16 length) {
 	}
 }
 
+void MidiPlayer::onTrackStart() {
+	if (_driver)
+		_driver->onTrackStart();
+}
+
 void MidiPlayer::endOfTrack() {
 	if (_isLooping) {
 		assert(_parser);
@@ -117,6 +117,7 @@ public:
 	// MidiDriver_BASE implementation
 	virtual void send(uint32 b) override;
 	virtual void metaEvent(byte type, byte *data, uint16 length) override;
+	virtual void onTrackStart() override;
 
 protected:
 	/**
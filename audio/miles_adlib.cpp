@@ -124,6 +124,7 @@ public:
 	int open() override;
 	void close() override;
 	void send(uint32 b) override;
+	void onTrackStart() override;
 	MidiChannel *allocateChannel() override { return NULL; }
 	MidiChannel *getPercussionChannel() override { return NULL; }
 
@@ -332,6 +333,11 @@ void MidiDriver_Miles_AdLib::close() {
 	_isOpen = false;
 }
 
+void MidiDriver_Miles_AdLib::onTrackStart() {
+	if (_isOpen)
+		_opl->startTrack();
+}
+
 void MidiDriver_Miles_AdLib::setVolume(byte volume) {
 	_masterVolume = volume;
 	//renewNotes(-1, true);
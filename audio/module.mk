@@ -16,6 +16,8 @@ MODULE_OBJS := \
 	mpu401.o \
 	musicplugin.o \
 	null.o \
+	renderahead.o \
+	rendercache.o \
 	timestamp.o \
 	decoders/3do.o \
 	decoders/aac.o \
@@ -0,0 +1,203 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/renderahead.h"
+
+#include "common/array.h"
+#include "common/config-manager.h"
+#include "common/singleton.h"
+#include "common/system.h"
+#include "common/timer.h"
+
+namespace Audio {
+
+enum {
+	// Timer proc interval, in microseconds
+	kFillInterval = 5000,
+	// Most audio rendered per buffer and timer tick, in milliseconds. It is
+	// larger than the interval so that the buffer can catch up, but small
+	// enough that one buffer can't hold up the timer thread for long.
+	kFillSlice = 20
+};
+
+/**
+ * The active render-ahead buffers, all filled from a single timer proc.
+ * removeTimerProc removes every timer using the same proc, so each buffer
+ * can't have its own.
+ */
+class RenderAheadManager : public Common::Singleton<RenderAheadManager> {
+public:
+	void add(RenderAheadBuffer *buffer);
+	void remove(RenderAheadBuffer *buffer);
+
+private:
+	static void timerProc(void *refCon);
+
+	Common::Array<RenderAheadBuffer *> _buffers;
+
+	/** Protects _buffers, and is held by the timer proc. */
+	Common::Mutex _buffersMutex;
+
+	/** Serializes installing and removing the timer proc. */
+	Common::Mutex _timerMutex;
+};
+
+void RenderAheadManager::add(RenderAheadBuffer *buffer) {
+	Common::StackLock timerLock(_timerMutex);
+	bool install;
+
+	{
+		Common::StackLock lock(_buffersMutex);
+		install = _buffers.empty();
+		_buffers.push_back(buffer);
+	}
+
+	if (install)
+		g_system->getTimerManager()->installTimerProc(&timerProc, kFillInterval, this, "RenderAhead");
+}
+
+void RenderAheadManager::remove(RenderAheadBuffer *buffer) {
+	Common::StackLock timerLock(_timerMutex);
+	bool uninstall = false;
+
+	{
+		Common::StackLock lock(_buffersMutex);
+		for (uint i = 0; i < _buffers.size(); ++i) {
+			if (_buffers[i] == buffer) {
+				_buffers.remove_at(i);
+				uninstall = _buffers.empty();
+				break;
+			}
+		}
+	}
+
+	// The timer manager's lock is held while the timer proc runs, so this
+	// must not be called with _buffersMutex held.
+	if (uninstall)
+		g_system->getTimerManager()->removeTimerProc(&timerProc);
+}
+
+void RenderAheadManager::timerProc(void *refCon) {
+	RenderAheadManager *manager = (RenderAheadManager *)refCon;
+	Common::StackLock lock(manager->_buffersMutex);
+
+	for (uint i = 0; i < manager->_buffers.size(); ++i)
+		manager->_buffers[i]->fill();
+}
+
+RenderAheadBuffer::RenderAheadBuffer(RenderProc proc, void *refCon, int rate, bool stereo, uint latency) :
+	_proc(proc), _refCon(refCon), _readPos(0), _writePos(0), _underruns(0) {
+	const uint channels = stereo ? 2 : 1;
+
+	// Keep whole frames, so that stereo samples never get split
+	_target = (rate * latency / 1000) * channels;
+	_target = MAX<uint32>(_target, 256 * channels);
+	_slice = MAX<uint32>((rate * kFillSlice / 1000) * channels, 256 * channels);
+
+	uint32 size = 1;
+	while (size < _target)
+		size <<= 1;
+	_mask = size - 1;
+	_buffer = new int16[size];
+
+	RenderAheadManager::instance().add(this);
+}
+
+RenderAheadBuffer::~RenderAheadBuffer() {
+	RenderAheadManager::instance().remove(this);
+	delete[] _buffer;
+}
+
+uint RenderAheadBuffer::getConfiguredLatency() {
+	if (!ConfMan.hasKey("render_ahead"))
+		return 0;
+	return MAX(ConfMan.getInt("render_ahead"), 0);
+}
+
+void RenderAheadBuffer::fill() {
+	Common::StackLock renderLock(_renderMutex);
+	uint32 used;
+
+	{
+		Common::StackLock lock(_positionMutex);
+		used = _writePos - _readPos;
+	}
+
+	// Only the thread holding _renderMutex writes, and the reader never goes
+	// past _writePos, so the free part of the buffer can be filled unlocked.
+	// The rest is left for the next timer tick.
+	uint32 count = (used < _target) ? MIN(_target - used, _slice) : 0;
+	while (count) {
+		const uint32 start = _writePos & _mask;
+		const uint32 chunk = MIN(count, _mask + 1 - start);
+
+		_proc(_refCon, _buffer + start, chunk);
+
+		Common::StackLock lock(_positionMutex);
+		_writePos += chunk;
+		count -= chunk;
+	}
+}
+
+int RenderAheadBuffer::drain(int16 *buffer, int numSamples) {
+	uint32 available;
+
+	{
+		Common::StackLock lock(_positionMutex);
+		available = _writePos - _readPos;
+	}
+
+	const uint32 count = MIN<uint32>(available, numSamples);
+	const uint32 start = _readPos & _mask;
+	const uint32 first = MIN(count, _mask + 1 - start);
+
+	memcpy(buffer, _buffer + start, first * sizeof(int16));
+	memcpy(buffer + first, _buffer, (count - first) * sizeof(int16));
+
+	Common::StackLock lock(_positionMutex);
+	_readPos += count;
+	return count;
+}
+
+int RenderAheadBuffer::readBuffer(int16 *buffer, const int numSamples) {
+	int done = drain(buffer, numSamples);
+
+	if (done < numSamples) {
+		// Nothing more can be rendered ahead while this lock is held, so any
+		// samples after what's left in the buffer can be rendered here.
+		Common::StackLock renderLock(_renderMutex);
+		done += drain(buffer + done, numSamples - done);
+
+		if (done < numSamples) {
+			_underruns++;
+			_proc(_refCon, buffer + done, numSamples - done);
+		}
+	}
+
+	return numSamples;
+}
+
+} // End of namespace Audio
+
+namespace Common {
+DECLARE_SINGLETON(Audio::RenderAheadManager);
+}
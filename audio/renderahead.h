@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_RENDERAHEAD_H
+#define AUDIO_RENDERAHEAD_H
+
+#include "common/mutex.h"
+#include "common/scummsys.h"
+
+namespace Audio {
+
+/**
+ * Renders the output of a software synthesizer ahead of time on the timer
+ * thread, so an expensive emulator doesn't have to produce all of its samples
+ * inside the mixer callback. Rendered samples are kept in a ring buffer which
+ * readBuffer drains; if it runs dry, the missing samples are rendered directly,
+ * just as they would be without render-ahead, and an underrun is counted.
+ *
+ * Everything the synthesizer does while rendering, including calling the
+ * music driver's timer callback, happens on whichever thread renders, so it
+ * stays in step with the sample position. Changes made directly by the engine
+ * take effect at the render position, i.e. up to the latency later than they
+ * would otherwise be heard.
+ *
+ * Render-ahead is enabled with the "render_ahead" setting, which gives the
+ * latency in milliseconds.
+ */
+class RenderAheadBuffer {
+public:
+	/**
+	 * Callback which renders the given number of samples, counting left and
+	 * right channel samples separately for stereo output.
+	 */
+	typedef void (*RenderProc)(void *refCon, int16 *buffer, int numSamples);
+
+	RenderAheadBuffer(RenderProc proc, void *refCon, int rate, bool stereo, uint latency);
+	~RenderAheadBuffer();
+
+	/**
+	 * Fill the buffer with the next samples, as AudioStream::readBuffer would.
+	 */
+	int readBuffer(int16 *buffer, const int numSamples);
+
+	/**
+	 * Number of times the mixer asked for more samples than had been rendered.
+	 */
+	uint32 getUnderruns() const { return _underruns; }
+
+	/**
+	 * Returns the latency configured with the "render_ahead" setting, in
+	 * milliseconds, or 0 if render-ahead is disabled.
+	 */
+	static uint getConfiguredLatency();
+
+	/**
+	 * Render samples until the buffer holds the requested latency, but no
+	 * more than a slice of it at a time. This is called regularly from the
+	 * timer thread.
+	 */
+	void fill();
+
+private:
+	int drain(int16 *buffer, int numSamples);
+
+	RenderProc _proc;
+	void *_refCon;
+
+	int16 *_buffer;
+	uint32 _mask;
+	uint32 _target;
+
+	/** Most samples rendered by one call to fill(). */
+	uint32 _slice;
+
+	/** Total samples read and written, which wrap around together with the buffer. */
+	uint32 _readPos, _writePos;
+
+	/** Protects _readPos and _writePos, and is only held briefly. */
+	Common::Mutex _positionMutex;
+
+	/** Held while samples are being rendered. */
+	Common::Mutex _renderMutex;
+
+	uint32 _underruns;
+};
+
+} // End of namespace Audio
+
+#endif
@@ -0,0 +1,847 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/rendercache.h"
+
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/endian.h"
+#include "common/savefile.h"
+#include "common/singleton.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "common/timer.h"
+
+namespace Audio {
+
+enum {
+	// About a second with the usual 250Hz timer
+	kProbeTicks = 250,
+	kIdleTicks = 1250,
+	kMaxSeconds = 600,
+	kMaxEntries = 1 << 21,
+	kReadAheadSeconds = 2,
+	// In megabytes
+	kDefaultCacheSize = 256
+};
+
+static const char *const kIndexFileName = "rendercache.idx";
+
+/**
+ * The active render caches, whose files are all read and written from a
+ * single timer proc, and the index of cache files, which keeps their total
+ * size within the "music_render_cache_size" limit.
+ */
+class RenderCacheManager : public Common::Singleton<RenderCacheManager> {
+public:
+	RenderCacheManager() : _indexLoaded(false), _useCount(0), _sizeLimit(0) {}
+
+	void add(RenderCache *cache);
+	void remove(RenderCache *cache);
+
+	/**
+	 * A track is played from a cache file, which makes the file the last one
+	 * to be removed.
+	 */
+	void touchFile(const Common::String &fileName);
+
+	/**
+	 * A track is about to be recorded again, so its old files are removed.
+	 */
+	void removeFile(const Common::String &fileName);
+
+	/**
+	 * A cache file has been written. The least recently played files are
+	 * removed while the cache is over its size limit.
+	 */
+	void addFile(const Common::String &fileName, uint32 size);
+
+private:
+	struct IndexEntry {
+		Common::String fileName;
+		uint32 size;
+		uint32 lastUse;
+	};
+
+	static void timerProc(void *refCon);
+
+	void loadIndex();
+	void saveIndex();
+	int findFile(const Common::String &fileName) const;
+	static void deleteFiles(const Common::String &fileName);
+
+	Common::Array<RenderCache *> _caches;
+
+	/** Protects _caches, and is held by the timer proc. */
+	Common::Mutex _cachesMutex;
+
+	/** Serializes installing and removing the timer proc. */
+	Common::Mutex _timerMutex;
+
+	Common::Array<IndexEntry> _index;
+	bool _indexLoaded;
+	uint32 _useCount;
+	uint64 _sizeLimit;
+
+	/** Protects the index, which caches update after they leave the timer proc, too. */
+	Common::Mutex _indexMutex;
+};
+
+void RenderCacheManager::add(RenderCache *cache) {
+	{
+		Common::StackLock lock(_indexMutex);
+		const int size = ConfMan.hasKey("music_render_cache_size") ? ConfMan.getInt("music_render_cache_size") : kDefaultCacheSize;
+		_sizeLimit = (uint64)MAX(size, 0) * 1024 * 1024;
+
+		// Before any cache file is written, so all files missing from the index
+		// are leftovers
+		if (!_indexLoaded)
+			loadIndex();
+	}
+
+	Common::StackLock timerLock(_timerMutex);
+	bool install;
+
+	{
+		Common::StackLock lock(_cachesMutex);
+		install = _caches.empty();
+		_caches.push_back(cache);
+	}
+
+	if (install)
+		g_system->getTimerManager()->installTimerProc(&timerProc, 20000, this, "RenderCache");
+}
+
+void RenderCacheManager::remove(RenderCache *cache) {
+	Common::StackLock timerLock(_timerMutex);
+	bool uninstall = false;
+
+	{
+		Common::StackLock lock(_cachesMutex);
+		for (uint i = 0; i < _caches.size(); ++i) {
+			if (_caches[i] == cache) {
+				_caches.remove_at(i);
+				uninstall = _caches.empty();
+				break;
+			}
+		}
+	}
+
+	// The timer manager's lock is held while the timer proc runs, so this
+	// must not be called with _cachesMutex held.
+	if (uninstall)
+		g_system->getTimerManager()->removeTimerProc(&timerProc);
+}
+
+void RenderCacheManager::timerProc(void *refCon) {
+	RenderCacheManager *manager = (RenderCacheManager *)refCon;
+	Common::StackLock lock(manager->_cachesMutex);
+
+	for (uint i = 0; i < manager->_caches.size(); ++i)
+		manager->_caches[i]->handleIO();
+}
+
+void RenderCacheManager::touchFile(const Common::String &fileName) {
+	Common::StackLock lock(_indexMutex);
+
+	const int i = findFile(fileName);
+	if (i >= 0) {
+		_index[i].lastUse = ++_useCount;
+		saveIndex();
+	}
+}
+
+void RenderCacheManager::removeFile(const Common::String &fileName) {
+	Common::StackLock lock(_indexMutex);
+
+	deleteFiles(fileName);
+	const int i = findFile(fileName);
+	if (i >= 0) {
+		_index.remove_at(i);
+		saveIndex();
+	}
+}
+
+void RenderCacheManager::addFile(const Common::String &fileName, uint32 size) {
+	Common::StackLock lock(_indexMutex);
+
+	int i = findFile(fileName);
+	if (i < 0) {
+		i = _index.size();
+		_index.push_back(IndexEntry());
+		_index[i].fileName = fileName;
+	}
+	_index[i].size = size;
+	_index[i].lastUse = ++_useCount;
+
+	uint64 total = 0;
+	for (i = 0; i < (int)_index.size(); ++i)
+		total += _index[i].size;
+
+	while (total > _sizeLimit && !_index.empty()) {
+		uint oldest = 0;
+		for (uint j = 1; j < _index.size(); ++j) {
+			if (_index[j].lastUse < _index[oldest].lastUse)
+				oldest = j;
+		}
+
+		debug(1, "RenderCache: Removing '%s' to stay within %u MB", _index[oldest].fileName.c_str(), (uint)(_sizeLimit >> 20));
+		total -= _index[oldest].size;
+		deleteFiles(_index[oldest].fileName);
+		_index.remove_at(oldest);
+	}
+
+	saveIndex();
+}
+
+void RenderCacheManager::loadIndex() {
+	Common::SaveFileManager *saveMan = g_system->getSavefileManager();
+	_indexLoaded = true;
+	_index.clear();
+
+	Common::InSaveFile *in = saveMan->openForLoading(kIndexFileName);
+	if (in && in->readUint32BE() == MKTAG('R', 'C', 'I', '1')) {
+		_useCount = in->readUint32LE();
+		const uint32 numEntries = in->readUint32LE();
+		for (uint32 i = 0; i < numEntries && !in->err() && !in->eos(); ++i) {
+			IndexEntry entry;
+			entry.fileName = in->readPascalString(false);
+			entry.size = in->readUint32LE();
+			entry.lastUse = in->readUint32LE();
+			if (!in->err() && !in->eos())
+				_index.push_back(entry);
+		}
+	}
+	delete in;
+
+	// Remove files left behind by recordings which never finished, and
+	// entries whose files have gone
+	const Common::StringArray files = saveMan->listSavefiles("rendercache-*");
+	bool changed = false;
+	for (uint i = 0; i < files.size(); ++i) {
+		const Common::String fileName(files[i].c_str(), files[i].size() - MIN<uint>(files[i].size(), 4));
+		if (findFile(fileName) < 0)
+			saveMan->removeSavefile(files[i]);
+	}
+	for (uint i = 0; i < _index.size();) {
+		bool found = false;
+		for (uint j = 0; j < files.size() && !found; ++j)
+			found = files[j] == _index[i].fileName + ".mrl";
+		if (found) {
+			++i;
+		} else {
+			deleteFiles(_index[i].fileName);
+			_index.remove_at(i);
+			changed = true;
+		}
+	}
+
+	if (changed)
+		saveIndex();
+}
+
+void RenderCacheManager::saveIndex() {
+	Common::OutSaveFile *out = g_system->getSavefileManager()->openForSaving(kIndexFileName, false);
+	if (!out)
+		return;
+
+	out->writeUint32BE(MKTAG('R', 'C', 'I', '1'));
+	out->writeUint32LE(_useCount);
+	out->writeUint32LE(_index.size());
+	for (uint i = 0; i < _index.size(); ++i) {
+		out->writeByte(_index[i].fileName.size());
+		out->writeString(_index[i].fileName);
+		out->writeUint32LE(_index[i].size);
+		out->writeUint32LE(_index[i].lastUse);
+	}
+	out->finalize();
+	if (out->err())
+		warning("RenderCache: Could not write '%s'", kIndexFileName);
+	delete out;
+}
+
+int RenderCacheManager::findFile(const Common::String &fileName) const {
+	for (uint i = 0; i < _index.size(); ++i) {
+		if (_index[i].fileName == fileName)
+			return i;
+	}
+	return -1;
+}
+
+void RenderCacheManager::deleteFiles(const Common::String &fileName) {
+	Common::SaveFileManager *saveMan = g_system->getSavefileManager();
+
+	// The index first, so a partly removed track can't be played
+	saveMan->removeSavefile(fileName + ".mrl");
+	saveMan->removeSavefile(fileName + ".mrp");
+}
+
+RenderCache::RenderCache(const Common::String &name, int rate, bool stereo) :
+	_prefix(Common::String::format("rendercache-%s-%s", ConfMan.getActiveDomainName().c_str(), name.c_str())),
+	_rate(rate), _channels(stereo ? 2 : 1),
+	_state(kStateIdle), _replayStopped(false), _stateHash(0), _tick(0), _frame(0), _generation(0),
+	_replayLog(nullptr), _logPos(0), _recording(nullptr), _lookupDone(false), _pcmFrames(0),
+	_ringFrames(rate * kReadAheadSeconds), _ringRead(0), _ringStart(0), _ringFill(0),
+	_pcmIn(nullptr), _pcmInGeneration(0) {
+	_pcmInLast[0] = _pcmInLast[1] = 0;
+	_ring.resize(_ringFrames * _channels);
+
+	RenderCacheManager::instance().add(this);
+}
+
+RenderCache::~RenderCache() {
+	RenderCacheManager::instance().remove(this);
+
+	// The timer proc doesn't see this cache any more, so the recordings which
+	// are still waiting to be written can be written here
+	{
+		Common::StackLock lock(_mutex);
+		if (_state == kStateRecording)
+			discardRecording();
+	}
+	writeRecordings();
+
+	delete _pcmIn;
+	delete _replayLog;
+}
+
+bool RenderCache::isEnabled() {
+	return ConfMan.hasKey("music_render_cache") && ConfMan.getBool("music_render_cache");
+}
+
+uint32 RenderCache::hash(const void *data, uint32 size, uint32 seed) {
+	// FNV-1a
+	const byte *p = (const byte *)data;
+	uint32 h = seed;
+	while (size--) {
+		h ^= *p++;
+		h *= 16777619;
+	}
+	return h;
+}
+
+void RenderCache::startTrack(uint32 stateHash) {
+	Common::StackLock lock(_mutex);
+
+	finishTrack();
+	_stateHash = stateHash;
+	_state = kStateStarting;
+}
+
+void RenderCache::tick() {
+	Common::StackLock lock(_mutex);
+
+	switch (_state) {
+	case kStateStarting:
+		_state = kStateProbing;
+		_tick = 0;
+		_frame = 0;
+		_log.clear();
+		_probeSamples.clear();
+		break;
+	case kStateReplaying:
+		++_tick;
+		// Inputs expected at an earlier tick never arrived
+		if (_logPos < _replayLog->size() && (*_replayLog)[_logPos].tick < _tick)
+			stopReplay();
+		break;
+	case kStateProbing:
+		++_tick;
+		if (_tick >= kProbeTicks)
+			endProbe();
+		break;
+	case kStateLookingUp:
+		++_tick;
+		if (_lookupDone)
+			endLookup();
+		break;
+	case kStateRecording:
+		++_tick;
+		// The track has ended, or at least paused for long enough
+		if (_tick - (_recording->log.empty() ? 0 : _recording->log.back().tick) > kIdleTicks)
+			finishTrack();
+		break;
+	default:
+		break;
+	}
+}
+
+bool RenderCache::input(uint32 value) {
+	Common::StackLock lock(_mutex);
+
+	switch (_state) {
+	case kStateProbing:
+	case kStateLookingUp:
+	case kStateRecording: {
+		Common::Array<Entry> &log = (_state == kStateRecording) ? _recording->log : _log;
+		if (log.size() >= kMaxEntries) {
+			if (_state == kStateRecording)
+				discardRecording();
+			++_generation;
+			_state = kStateIdle;
+			_log.clear();
+			_probeSamples.clear();
+			return false;
+		}
+		log.push_back(Entry(_tick, value));
+		return false;
+	}
+	case kStateReplaying:
+		if (_logPos < _replayLog->size() && (*_replayLog)[_logPos].tick == _tick && (*_replayLog)[_logPos].value == value) {
+			++_logPos;
+			return true;
+		}
+		stopReplay();
+		return false;
+	default:
+		return false;
+	}
+}
+
+int RenderCache::readSamples(int16 *buffer, int numFrames) {
+	Common::StackLock lock(_mutex);
+
+	if (_state != kStateReplaying)
+		return 0;
+
+	const uint32 frames = MIN<uint32>(MIN<uint32>(numFrames, _ringFill), _pcmFrames - _frame);
+	const uint32 first = MIN(frames, _ringFrames - _ringRead);
+	memcpy(buffer, _ring.begin() + _ringRead * _channels, first * _channels * sizeof(int16));
+	memcpy(buffer + first * _channels, _ring.begin(), (frames - first) * _channels * sizeof(int16));
+
+	_ringRead = (_ringRead + frames) % _ringFrames;
+	_ringStart += frames;
+	_ringFill -= frames;
+	_frame += frames;
+
+	// Either the track is over, or reading ahead couldn't keep up
+	if (frames < (uint32)numFrames)
+		stopReplay();
+	return frames;
+}
+
+void RenderCache::addSamples(const int16 *buffer, int numFrames) {
+	Common::StackLock lock(_mutex);
+
+	switch (_state) {
+	case kStateProbing:
+	case kStateLookingUp:
+		for (int i = 0; i < numFrames * _channels; ++i)
+			_probeSamples.push_back(buffer[i]);
+		_frame += numFrames;
+		break;
+	case kStateRecording:
+		for (int i = 0; i < numFrames * _channels; ++i)
+			_recording->samples.push_back(buffer[i]);
+		_frame += numFrames;
+		if (_frame > (uint32)_rate * kMaxSeconds)
+			discardRecording();
+		break;
+	default:
+		break;
+	}
+}
+
+void RenderCache::finishTrack() {
+	switch (_state) {
+	case kStateRecording:
+		if (_frame < (uint32)_rate * 2 || _recording->log.empty()) {
+			discardRecording();
+		} else {
+			// The timer thread writes the rest of the samples and the index
+			_recording->frames = _frame;
+			_recording->finished = true;
+			_recording = nullptr;
+		}
+		break;
+	case kStateReplaying:
+		stopReplay();
+		break;
+	default:
+		break;
+	}
+
+	++_generation;
+	_state = kStateIdle;
+	_log.clear();
+	_probeSamples.clear();
+}
+
+void RenderCache::endProbe() {
+	// The synth state and the inputs of the first ticks identify the track
+	byte buf[8];
+	WRITE_LE_UINT32(buf, _stateHash);
+	uint32 key = hash(buf, 4);
+	for (uint i = 0; i < _log.size(); ++i) {
+		WRITE_LE_UINT32(buf, _log[i].tick);
+		WRITE_LE_UINT32(buf + 4, _log[i].value);
+		key = hash(buf, 8, key);
+	}
+
+	// Keep rendering live until the timer thread has looked for the file
+	_fileName = Common::String::format("%s-%08x", _prefix.c_str(), key);
+	_lookupDone = false;
+	_ringRead = _ringStart = _ringFill = 0;
+	_state = kStateLookingUp;
+}
+
+void RenderCache::endLookup() {
+	// Make sure this really is the same track so far. This is called before
+	// the timer callback, so all inputs before the current tick have arrived.
+	bool ok = _replayLog != nullptr;
+	uint pos = 0;
+	while (ok && pos < _log.size()) {
+		ok = pos < _replayLog->size() && (*_replayLog)[pos].tick == _log[pos].tick && (*_replayLog)[pos].value == _log[pos].value;
+		++pos;
+	}
+	ok = ok && (pos == _replayLog->size() || (*_replayLog)[pos].tick >= _tick);
+
+	// The samples read ahead have to cover what was rendered live meanwhile
+	ok = ok && _frame >= _ringStart && _frame < _ringStart + _ringFill;
+
+	if (!ok) {
+		delete _replayLog;
+		_replayLog = nullptr;
+		++_generation;
+		startRecording();
+		return;
+	}
+
+	const uint32 skip = _frame - _ringStart;
+	_ringRead = (_ringRead + skip) % _ringFrames;
+	_ringStart += skip;
+	_ringFill -= skip;
+
+	_logPos = pos;
+	_log.clear();
+	_probeSamples.clear();
+	_state = kStateReplaying;
+}
+
+void RenderCache::stopReplay() {
+	delete _replayLog;
+	_replayLog = nullptr;
+	++_generation;
+	_ringRead = _ringStart = _ringFill = 0;
+	_state = kStateIdle;
+	_replayStopped = true;
+}
+
+bool RenderCache::replayStopped() {
+	Common::StackLock lock(_mutex);
+
+	const bool stopped = _replayStopped;
+	_replayStopped = false;
+	return stopped;
+}
+
+void RenderCache::startRecording() {
+	_recording = new Recording();
+	_recording->fileName = _fileName;
+	_recording->stateHash = _stateHash;
+	_recording->log = _log;
+	_recording->samples = _probeSamples;
+	_recordings.push_back(_recording);
+
+	_log.clear();
+	_probeSamples.clear();
+	_state = kStateRecording;
+}
+
+void RenderCache::discardRecording() {
+	_recording->discarded = true;
+	_recording->log.clear();
+	_recording->samples.clear();
+	_recording = nullptr;
+	_state = kStateIdle;
+}
+
+void RenderCache::handleIO() {
+	lookUpTrack();
+	readAhead();
+	writeRecordings();
+}
+
+void RenderCache::lookUpTrack() {
+	Common::String fileName;
+	uint32 stateHash, generation, frame;
+
+	{
+		Common::StackLock lock(_mutex);
+		if (_state != kStateLookingUp || _lookupDone)
+			return;
+		fileName = _fileName;
+		stateHash = _stateHash;
+		generation = _generation;
+		frame = _frame;
+	}
+
+	delete _pcmIn;
+	_pcmIn = nullptr;
+
+	uint32 pcmFrames = 0;
+	uint32 numFrames = 0;
+	Common::Array<int16> samples;
+	Common::Array<Entry> *log = loadLog(fileName, stateHash, pcmFrames);
+	if (log && frame < pcmFrames) {
+		_pcmIn = g_system->getSavefileManager()->openForLoading(fileName + ".mrp");
+		_pcmInLast[0] = _pcmInLast[1] = 0;
+		samples.resize(_ringFrames * _channels);
+
+		// The samples are delta coded, so the ones played live are decoded too
+		uint32 skipped = 0;
+		while (_pcmIn && skipped < frame) {
+			const uint32 read = readPCM(samples.begin(), MIN(_ringFrames, frame - skipped));
+			if (!read)
+				break;
+			skipped += read;
+		}
+		if (_pcmIn && skipped == frame)
+			numFrames = readPCM(samples.begin(), MIN(_ringFrames, pcmFrames - frame));
+	}
+	if (!numFrames) {
+		delete log;
+		log = nullptr;
+		delete _pcmIn;
+		_pcmIn = nullptr;
+	}
+
+	{
+		Common::StackLock lock(_mutex);
+		if (_generation == generation && _state == kStateLookingUp) {
+			_lookupDone = true;
+			_replayLog = log;
+			_pcmFrames = pcmFrames;
+			_pcmInGeneration = generation;
+			memcpy(_ring.begin(), samples.begin(), numFrames * _channels * sizeof(int16));
+			_ringRead = 0;
+			_ringStart = frame;
+			_ringFill = numFrames;
+			log = nullptr;
+		}
+	}
+
+	if (log) {
+		// The track was stopped meanwhile
+		delete log;
+		delete _pcmIn;
+		_pcmIn = nullptr;
+	} else if (_pcmIn) {
+		RenderCacheManager::instance().touchFile(fileName);
+	}
+}
+
+void RenderCache::readAhead() {
+	if (!_pcmIn)
+		return;
+
+	uint32 generation, remaining, numFrames;
+	bool active;
+
+	{
+		Common::StackLock lock(_mutex);
+		active = _generation == _pcmInGeneration && (_state == kStateLookingUp || _state == kStateReplaying);
+		generation = _generation;
+		remaining = _pcmFrames - (_ringStart + _ringFill);
+		numFrames = MIN(_ringFrames - _ringFill, remaining);
+	}
+
+	// The track has stopped, or all of it has been read
+	if (!active || !remaining) {
+		delete _pcmIn;
+		_pcmIn = nullptr;
+		return;
+	}
+
+	// Read in larger blocks, rather than a few samples every time
+	if (numFrames < _ringFrames / 4 && numFrames < remaining)
+		return;
+
+	Common::Array<int16> samples;
+	samples.resize(numFrames * _channels);
+	numFrames = readPCM(samples.begin(), numFrames);
+
+	Common::StackLock lock(_mutex);
+	if (_generation != generation)
+		return;
+
+	// The mixer only ever frees space in the ring, so the samples still fit
+	const uint32 start = (_ringRead + _ringFill) % _ringFrames;
+	const uint32 first = MIN(numFrames, _ringFrames - start);
+	memcpy(_ring.begin() + start * _channels, samples.begin(), first * _channels * sizeof(int16));
+	memcpy(_ring.begin(), samples.begin() + first * _channels, (numFrames - first) * _channels * sizeof(int16));
+	_ringFill += numFrames;
+}
+
+void RenderCache::writeRecordings() {
+	while (true) {
+		Recording *recording;
+		Common::Array<int16> samples;
+		bool done;
+
+		{
+			Common::StackLock lock(_mutex);
+			if (_recordings.empty())
+				return;
+			recording = _recordings.front();
+			samples = recording->samples;
+			recording->samples.clear();
+			done = recording->finished || recording->discarded;
+		}
+
+		// Once it's done, the mixer thread doesn't touch the recording any more
+		if (!recording->opened && !(done && recording->discarded)) {
+			recording->opened = true;
+			// Don't leave an index behind which doesn't match the samples
+			RenderCacheManager::instance().removeFile(recording->fileName);
+			recording->out = g_system->getSavefileManager()->openForSaving(recording->fileName + ".mrp");
+		}
+		if (recording->out)
+			writePCM(recording->out, recording->last, samples);
+
+		// Recordings are written in order, and this one is still going on
+		if (!done)
+			return;
+
+		closeRecording(recording);
+
+		Common::StackLock lock(_mutex);
+		_recordings.remove_at(0);
+		delete recording;
+	}
+}
+
+void RenderCache::closeRecording(Recording *recording) {
+	Common::SaveFileManager *saveMan = g_system->getSavefileManager();
+	bool ok = recording->finished && !recording->discarded && recording->out;
+
+	if (recording->out) {
+		recording->out->finalize();
+		ok = ok && !recording->out->err();
+		delete recording->out;
+		recording->out = nullptr;
+	}
+
+	// The size limit applies to the compressed samples
+	uint32 size = 0;
+	if (ok) {
+		Common::InSaveFile *raw = saveMan->openRawFile(recording->fileName + ".mrp");
+		ok = raw != nullptr;
+		if (raw) {
+			size = raw->size();
+			delete raw;
+		}
+	}
+
+	if (ok) {
+		Common::OutSaveFile *out = saveMan->openForSaving(recording->fileName + ".mrl", false);
+		ok = out != nullptr;
+
+		if (out) {
+			out->writeUint32BE(MKTAG('M', 'R', 'C', '2'));
+			out->writeUint32LE(_rate);
+			out->writeByte(_channels);
+			out->writeUint32LE(recording->stateHash);
+			out->writeUint32LE(recording->frames);
+			out->writeUint32LE(recording->log.size());
+			for (uint i = 0; i < recording->log.size(); ++i) {
+				out->writeUint32LE(recording->log[i].tick);
+				out->writeUint32LE(recording->log[i].value);
+			}
+			out->finalize();
+			ok = !out->err();
+			size += out->pos();
+			delete out;
+		}
+
+		if (!ok)
+			warning("RenderCache: Could not write '%s'", recording->fileName.c_str());
+	}
+
+	if (ok) {
+		RenderCacheManager::instance().addFile(recording->fileName, size);
+	} else if (recording->opened) {
+		saveMan->removeSavefile(recording->fileName + ".mrl");
+		saveMan->removeSavefile(recording->fileName + ".mrp");
+	}
+}
+
+Common::Array<RenderCache::Entry> *RenderCache::loadLog(const Common::String &fileName, uint32 stateHash, uint32 &pcmFrames) {
+	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(fileName + ".mrl");
+	if (!in)
+		return nullptr;
+
+	bool ok = in->readUint32BE() == MKTAG('M', 'R', 'C', '2')
+	       && in->readUint32LE() == (uint32)_rate
+	       && in->readByte() == _channels
+	       && in->readUint32LE() == stateHash;
+	pcmFrames = in->readUint32LE();
+	const uint32 numEntries = in->readUint32LE();
+	ok = ok && !in->err() && numEntries <= kMaxEntries;
+
+	Common::Array<Entry> *log = nullptr;
+	if (ok) {
+		log = new Common::Array<Entry>();
+		log->resize(numEntries);
+		for (uint i = 0; i < numEntries; ++i) {
+			(*log)[i].tick = in->readUint32LE();
+			(*log)[i].value = in->readUint32LE();
+		}
+		if (in->err() || in->eos()) {
+			delete log;
+			log = nullptr;
+		}
+	}
+	delete in;
+
+	return log;
+}
+
+uint32 RenderCache::readPCM(int16 *buffer, uint32 numFrames) {
+	const uint32 frameSize = _channels * sizeof(int16);
+	const uint32 read = _pcmIn->read(buffer, numFrames * frameSize) / frameSize;
+	for (uint32 i = 0; i < read * _channels; ++i) {
+		int16 &last = _pcmInLast[i % _channels];
+		last = (int16)((uint16)last + READ_LE_UINT16(buffer + i));
+		buffer[i] = last;
+	}
+	return read;
+}
+
+void RenderCache::writePCM(Common::WriteStream *out, int16 *last, const Common::Array<int16> &samples) {
+	// Storing the difference to the previous sample on the same channel
+	// leaves the compression a lot more to work with than the samples do
+	Common::Array<int16> deltas;
+	deltas.resize(samples.size());
+	for (uint i = 0; i < samples.size(); ++i) {
+		int16 &prev = last[i % _channels];
+		WRITE_LE_UINT16(deltas.begin() + i, (uint16)samples[i] - (uint16)prev);
+		prev = samples[i];
+	}
+	out->write(deltas.begin(), deltas.size() * sizeof(int16));
+}
+
+} // End of namespace Audio
+
+namespace Common {
+DECLARE_SINGLETON(Audio::RenderCacheManager);
+}
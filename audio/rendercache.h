@@ -0,0 +1,246 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_RENDERCACHE_H
+#define AUDIO_RENDERCACHE_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/scummsys.h"
+#include "common/str.h"
+
+namespace Common {
+class OutSaveFile;
+class SeekableReadStream;
+class WriteStream;
+}
+
+namespace Audio {
+
+class RenderCacheManager;
+
+/**
+ * Caches the output of a software synthesizer for a piece of music, so that
+ * the next time the same music plays from the same synth state, it can be
+ * streamed from disk instead of being synthesized again.
+ *
+ * The owner reports the start of each track with startTrack(), each timer
+ * tick with tick(), every input to the synth (MIDI messages, register writes)
+ * with input(), and gets its samples from readSamples() before rendering the
+ * rest and passing them to addSamples().
+ *
+ * The first second of a track is always rendered live. The inputs received
+ * during that time identify the track; if a cache file exists for it, the
+ * rest of the track is read from that file for as long as the inputs keep
+ * matching the recorded ones at the same ticks. Any deviation, such as a
+ * tempo or volume change, ends playback from the cache, and the owner goes
+ * back to live synthesis. Without a cache file, the track is recorded and
+ * written to the saves directory when the next track starts, e.g. when the
+ * music loops. The samples are stored delta coded and compressed.
+ *
+ * The methods above are called from the mixer thread and the music thread,
+ * and never touch the disk. Owners which lock themselves around these calls
+ * must always do so before the cache locks itself, and the cache never
+ * calls back into its owner. When playback from the cache stops, the owner
+ * learns it from replayStopped() and brings the synth up to date. Cache
+ * files are looked up, read ahead and written on the timer thread instead,
+ * and the least recently played ones are removed when the cache grows past
+ * its size limit.
+ *
+ * The cache is enabled with the "music_render_cache" setting, and its size
+ * is limited by "music_render_cache_size", in megabytes.
+ */
+class RenderCache {
+	friend class RenderCacheManager;
+
+public:
+	/**
+	 * @param name		identifies the synth in cache file names
+	 * @param rate		output rate
+	 * @param stereo	whether the output is stereo
+	 */
+	RenderCache(const Common::String &name, int rate, bool stereo);
+	~RenderCache();
+
+	/**
+	 * Whether the cache is enabled with the "music_render_cache" setting.
+	 */
+	static bool isEnabled();
+
+	/**
+	 * A track starts playing with the next tick.
+	 *
+	 * @param stateHash	identifies the state of the synth, e.g. its registers
+	 */
+	void startTrack(uint32 stateHash);
+
+	/**
+	 * The synth's timer callback is about to be called.
+	 */
+	void tick();
+
+	/**
+	 * Report an input to the synth.
+	 *
+	 * @return true if the input was expected by the track played from the
+	 *         cache, false if it has to be passed on to the synth
+	 */
+	bool input(uint32 value);
+
+	/**
+	 * Read samples from the cache.
+	 *
+	 * @return the number of sample frames read, which is less than requested
+	 *         (usually 0) when the rest has to be rendered live
+	 */
+	int readSamples(int16 *buffer, int numFrames);
+
+	/**
+	 * Report samples which were rendered live.
+	 */
+	void addSamples(const int16 *buffer, int numFrames);
+
+	bool isReplaying() const { return _state == kStateReplaying; }
+
+	/**
+	 * Whether playback from the cache stopped since the last call, so that
+	 * synths which don't see their inputs during playback can catch up.
+	 */
+	bool replayStopped();
+
+	/**
+	 * Hash function used for cache keys, also useful for hashing the synth
+	 * state and long inputs like SysEx messages.
+	 */
+	static uint32 hash(const void *data, uint32 size, uint32 seed = 2166136261U);
+
+private:
+	enum State {
+		kStateIdle,
+		kStateStarting,
+		kStateProbing,
+		kStateLookingUp,
+		kStateRecording,
+		kStateReplaying
+	};
+
+	struct Entry {
+		uint32 tick;
+		uint32 value;
+
+		Entry() : tick(0), value(0) {}
+		Entry(uint32 t, uint32 v) : tick(t), value(v) {}
+	};
+
+	/**
+	 * A track being recorded, or waiting to be written. The mixer thread only
+	 * adds samples to the current recording; once it is finished or discarded,
+	 * it belongs to the timer thread, which alone uses 'out'.
+	 */
+	struct Recording {
+		Common::String fileName;
+		uint32 stateHash;
+		uint32 frames;
+		Common::Array<Entry> log;
+		Common::Array<int16> samples;
+		bool finished;
+		bool discarded;
+		bool opened;
+		Common::OutSaveFile *out;
+		/** The last sample written on each channel, for delta coding. */
+		int16 last[2];
+
+		Recording() : stateHash(0), frames(0), finished(false), discarded(false), opened(false), out(nullptr) {
+			last[0] = last[1] = 0;
+		}
+	};
+
+	// Called with _mutex held, on the mixer thread
+	void finishTrack();
+	void endProbe();
+	void endLookup();
+	void stopReplay();
+	void startRecording();
+	void discardRecording();
+
+	// Called on the timer thread, or after the cache has been removed from it
+	void handleIO();
+	void lookUpTrack();
+	void readAhead();
+	void writeRecordings();
+	void closeRecording(Recording *recording);
+	Common::Array<Entry> *loadLog(const Common::String &fileName, uint32 stateHash, uint32 &pcmFrames);
+	uint32 readPCM(int16 *buffer, uint32 numFrames);
+	void writePCM(Common::WriteStream *out, int16 *last, const Common::Array<int16> &samples);
+
+	Common::String _prefix;
+	int _rate;
+	int _channels;
+
+	State _state;
+	bool _replayStopped;
+	uint32 _stateHash;
+	uint32 _tick;
+	uint32 _frame;
+	Common::String _fileName;
+
+	/** Changes whenever the track being looked up or replayed does. */
+	uint32 _generation;
+
+	/** Inputs received while identifying the current track. */
+	Common::Array<Entry> _log;
+
+	/** Inputs expected by the track being replayed, loaded from the cache file. */
+	Common::Array<Entry> *_replayLog;
+	uint _logPos;
+
+	/** Samples rendered while identifying the track. */
+	Common::Array<int16> _probeSamples;
+
+	/** The track being recorded, and all recordings which haven't been written yet. */
+	Recording *_recording;
+	Common::Array<Recording *> _recordings;
+
+	/** Whether the timer thread has looked up the track; _replayLog is set if it was found. */
+	bool _lookupDone;
+
+	/** Total frames of the track being replayed. */
+	uint32 _pcmFrames;
+
+	/** Samples read ahead from the cache file: _ringFill frames from _ringStart on. */
+	Common::Array<int16> _ring;
+	uint32 _ringFrames;
+	uint32 _ringRead;
+	uint32 _ringStart;
+	uint32 _ringFill;
+
+	/** The cache file being read by the timer thread, and the track it belongs to. */
+	Common::SeekableReadStream *_pcmIn;
+	uint32 _pcmInGeneration;
+	int16 _pcmInLast[2];
+
+	Common::Mutex _mutex;
+};
+
+} // End of namespace Audio
+
+#endif
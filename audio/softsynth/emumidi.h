@@ -26,6 +26,8 @@
 #include "audio/audiostream.h"
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
+#include "audio/renderahead.h"
+#include "audio/rendercache.h"
 
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
@@ -44,12 +46,90 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	Audio::RenderAheadBuffer *_renderAhead;
+
+	static void renderAheadProc(void *refCon, int16 *data, int numSamples) {
+		((MidiDriver_Emulated *)refCon)->renderSamples(data, numSamples);
+	}
+
 protected:
 	int _baseFreq;
 
+	/**
+	 * Caches the rendered music if enabled with the "music_render_cache"
+	 * setting. Subclasses which create it report their inputs and the
+	 * start of tracks to it.
+	 */
+	Audio::RenderCache *_renderCache;
+
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Start rendering ahead on the timer thread, if enabled with the
+	 * "render_ahead" setting. Subclasses with expensive synths call this
+	 * once they're ready to generate samples, and must call
+	 * stopRenderAhead before they're closed.
+	 */
+	void startRenderAhead() {
+		const uint latency = Audio::RenderAheadBuffer::getConfiguredLatency();
+		if (latency && !_renderAhead)
+			_renderAhead = new Audio::RenderAheadBuffer(&renderAheadProc, this, getRate(), isStereo(), latency);
+	}
+
+	void stopRenderAhead() {
+		delete _renderAhead;
+		_renderAhead = nullptr;
+	}
+
+	void startRenderCache(const Common::String &name) {
+		if (Audio::RenderCache::isEnabled() && !_renderCache)
+			_renderCache = new Audio::RenderCache(name, getRate(), isStereo());
+	}
+
+	void stopRenderCache() {
+		delete _renderCache;
+		_renderCache = nullptr;
+	}
+
+	/**
+	 * Generate samples, calling the timer callbacks at the right points.
+	 */
+	void renderSamples(int16 *data, const int numSamples) {
+		const int stereoFactor = isStereo() ? 2 : 1;
+		int len = numSamples / stereoFactor;
+		int step;
+
+		do {
+			step = len;
+			if (step > (_nextTick >> FIXP_SHIFT))
+				step = (_nextTick >> FIXP_SHIFT);
+
+			const int cached = _renderCache ? _renderCache->readSamples(data, step) : 0;
+			if (cached < step) {
+				generateSamples(data + cached * stereoFactor, step - cached);
+				if (_renderCache)
+					_renderCache->addSamples(data + cached * stereoFactor, step - cached);
+			}
+
+			_nextTick -= step << FIXP_SHIFT;
+			if (!(_nextTick >> FIXP_SHIFT)) {
+				if (_renderCache)
+					_renderCache->tick();
+
+				if (_timerProc)
+					(*_timerProc)(_timerParam);
+
+				onTimer();
+
+				_nextTick += _samplesPerTick;
+			}
+
+			data += step * stereoFactor;
+			len -= step;
+		} while (len);
+	}
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -58,7 +138,14 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
-		_baseFreq(250) {
+		_renderAhead(nullptr),
+		_baseFreq(250),
+		_renderCache(nullptr) {
+	}
+
+	virtual ~MidiDriver_Emulated() {
+		stopRenderAhead();
+		stopRenderCache();
 	}
 
 	// MidiDriver API
@@ -87,33 +174,20 @@ public:
 		return 1000000 / _baseFreq;
 	}
 
+	/**
+	 * Number of times rendering ahead couldn't keep up with the mixer.
+	 * Always 0 unless render-ahead is enabled.
+	 */
+	uint32 getRenderAheadUnderruns() const {
+		return _renderAhead ? _renderAhead->getUnderruns() : 0;
+	}
+
 	// AudioStream API
 	virtual int readBuffer(int16 *data, const int numSamples) {
-		const int stereoFactor = isStereo() ? 2 : 1;
-		int len = numSamples / stereoFactor;
-		int step;
-
-		do {
-			step = len;
-			if (step > (_nextTick >> FIXP_SHIFT))
-				step = (_nextTick >> FIXP_SHIFT);
-
-			generateSamples(data, step);
-
-			_nextTick -= step << FIXP_SHIFT;
-			if (!(_nextTick >> FIXP_SHIFT)) {
-				if (_timerProc)
-					(*_timerProc)(_timerParam);
-
-				onTimer();
-
-				_nextTick += _samplesPerTick;
-			}
-
-			data += step * stereoFactor;
-			len -= step;
-		} while (len);
+		if (_renderAhead)
+			return _renderAhead->readBuffer(data, numSamples);
 
+		renderSamples(data, numSamples);
 		return numSamples;
 	}
 
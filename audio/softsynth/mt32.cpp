@@ -113,6 +113,24 @@ private:
 
 	int _outputRate;
 
+	/**
+	 * What the music last told the synth on each channel, and what the synth
+	 * was actually sent, which falls behind while music is played from the
+	 * render cache. 0xFF marks values which were never set.
+	 */
+	struct ChannelState {
+		byte program;
+		byte controllers[120];
+		uint16 pitchBend;
+		byte notes[128];
+	};
+	ChannelState _channelState[16];
+	ChannelState _synthChannelState[16];
+	uint32 _sysExHash;
+
+	static void trackMessage(ChannelState *channelState, uint32 b);
+	void restoreChannelState();
+
 protected:
 	void generateSamples(int16 *buf, int len) override;
 
@@ -125,6 +143,7 @@ public:
 	void send(uint32 b) override;
 	void setPitchBendRange(byte channel, uint range) override;
 	void sysEx(const byte *msg, uint16 length) override;
+	void onTrackStart() override;
 
 	uint32 property(int prop, uint32 param) override;
 	MidiChannel *allocateChannel() override;
@@ -150,6 +169,7 @@ MidiDriver_MT32::MidiDriver_MT32(Audio::Mixer *mixer) : MidiDriver_Emulated(mixe
 	_outputRate = 0;
 	_controlData = nullptr;
 	_pcmData = nullptr;
+	_sysExHash = 0;
 }
 
 MidiDriver_MT32::~MidiDriver_MT32() {
@@ -175,7 +195,8 @@ int MidiDriver_MT32::open() {
 	debug(4, _s("Initializing MT-32 Emulator"));
 
 	Common::File controlFile;
-	if (!controlFile.open("CM32L_CONTROL.ROM") && !controlFile.open("MT32_CONTROL.ROM"))
+	const bool cm32l = controlFile.open("CM32L_CONTROL.ROM");
+	if (!cm32l && !controlFile.open("MT32_CONTROL.ROM"))
 		error("Error opening MT32_CONTROL.ROM / CM32L_CONTROL.ROM. Check that your Extra Path in Paths settings is set to the correct directory");
 
 	Common::File pcmFile;
@@ -220,6 +241,14 @@ int MidiDriver_MT32::open() {
 	_outputRate = _service.getActualStereoOutputSamplerate();
 
 	MidiDriver_Emulated::open();
+	startRenderAhead();
+
+	memset(_channelState, 0xFF, sizeof(_channelState));
+	for (int i = 0; i < 16; ++i)
+		memset(_channelState[i].notes, 0, sizeof(_channelState[i].notes));
+	memcpy(_synthChannelState, _channelState, sizeof(_channelState));
+	_sysExHash = 0;
+	startRenderCache(Common::String::format("%s-%d", cm32l ? "cm32l" : "mt32", ConfMan.getInt("midi_gain")));
 
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
@@ -229,10 +258,84 @@ int MidiDriver_MT32::open() {
 void MidiDriver_MT32::send(uint32 b) {
 	midiDriverCommonSend(b);
 
+	// The channel state is also used on the mixer thread. The driver is
+	// always locked before the render cache
 	Common::StackLock lock(_mutex);
+	if (_renderCache) {
+		// Messages the cached track expects are left out, the synth catches
+		// up with them when it is needed again
+		const bool cached = _renderCache->input(b);
+		trackMessage(_channelState, b);
+		if (cached)
+			return;
+		if (_renderCache->replayStopped())
+			restoreChannelState();
+		trackMessage(_synthChannelState, b);
+	}
+
 	_service.playMsg(b);
 }
 
+void MidiDriver_MT32::onTrackStart() {
+	Common::StackLock lock(_mutex);
+	if (_renderCache)
+		_renderCache->startTrack(Audio::RenderCache::hash(_channelState, sizeof(_channelState), _sysExHash));
+}
+
+void MidiDriver_MT32::trackMessage(ChannelState *channelState, uint32 b) {
+	ChannelState &state = channelState[b & 0x0F];
+	const byte param1 = (b >> 8) & 0x7F;
+	const byte param2 = (b >> 16) & 0x7F;
+
+	switch (b & 0xF0) {
+	case 0x80:
+		state.notes[param1] = 0;
+		break;
+	case 0x90:
+		state.notes[param1] = param2;
+		break;
+	case 0xB0:
+		if (param1 < ARRAYSIZE(state.controllers))
+			state.controllers[param1] = param2;
+		else if (param1 == 120 || param1 >= 123)
+			memset(state.notes, 0, sizeof(state.notes));
+		break;
+	case 0xC0:
+		state.program = param1;
+		break;
+	case 0xE0:
+		state.pitchBend = param1 | (param2 << 7);
+		break;
+	default:
+		break;
+	}
+}
+
+void MidiDriver_MT32::restoreChannelState() {
+	for (int ch = 0; ch < 16; ++ch) {
+		const ChannelState &from = _synthChannelState[ch];
+		const ChannelState &to = _channelState[ch];
+
+		for (int note = 0; note < 128; ++note) {
+			if (from.notes[note] && !to.notes[note])
+				_service.playMsg(0x80 | ch | (note << 8));
+		}
+		if (to.program != from.program && to.program != 0xFF)
+			_service.playMsg(0xC0 | ch | (to.program << 8));
+		for (int controller = 0; controller < ARRAYSIZE(to.controllers); ++controller) {
+			if (to.controllers[controller] != from.controllers[controller] && to.controllers[controller] != 0xFF)
+				_service.playMsg(0xB0 | ch | (controller << 8) | (to.controllers[controller] << 16));
+		}
+		if (to.pitchBend != from.pitchBend && to.pitchBend != 0xFFFF)
+			_service.playMsg(0xE0 | ch | ((to.pitchBend & 0x7F) << 8) | ((to.pitchBend >> 7) << 16));
+		for (int note = 0; note < 128; ++note) {
+			if (to.notes[note] && !from.notes[note])
+				_service.playMsg(0x90 | ch | (note << 8) | (to.notes[note] << 16));
+		}
+	}
+	memcpy(_synthChannelState, _channelState, sizeof(_channelState));
+}
+
 // Indiana Jones and the Fate of Atlantis (including the demo) uses
 // setPitchBendRange, if you need a game for testing purposes
 void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
@@ -241,13 +344,23 @@ void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
 	}
 	byte benderRangeSysex[4] = { 0, 0, 4, (uint8)range };
 	Common::StackLock lock(_mutex);
+	if (_renderCache) {
+		_sysExHash = Audio::RenderCache::hash(benderRangeSysex, sizeof(benderRangeSysex), _sysExHash ^ channel);
+		_renderCache->input(0xF0000000 | (_sysExHash & 0x0FFFFFFF));
+	}
 	_service.writeSysex(channel, benderRangeSysex, 4);
 }
 
 void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 	midiDriverCommonSysEx(msg, length);
+
+	// SysEx messages are always passed on, as they can't be replayed later
+	Common::StackLock lock(_mutex);
+	if (_renderCache) {
+		_sysExHash = Audio::RenderCache::hash(msg, length, _sysExHash);
+		_renderCache->input(0xF0000000 | (_sysExHash & 0x0FFFFFFF));
+	}
 	if (msg[0] == 0xf0) {
-		Common::StackLock lock(_mutex);
 		_service.playSysex(msg, length);
 	} else {
 		enum {
@@ -256,7 +369,6 @@ void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 		};
 
 		if (msg[3] == SYSEX_CMD_DT1 || msg[3] == SYSEX_CMD_DAT) {
-			Common::StackLock lock(_mutex);
 			_service.writeSysex(msg[1], msg + 4, length - 5);
 		} else {
 			warning("Unused sysEx command %d", msg[3]);
@@ -273,6 +385,8 @@ void MidiDriver_MT32::close() {
 	setTimerCallback(NULL, NULL);
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
+	stopRenderAhead();
+	stopRenderCache();
 
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
@@ -285,6 +399,8 @@ void MidiDriver_MT32::close() {
 
 void MidiDriver_MT32::generateSamples(int16 *data, int len) {
 	Common::StackLock lock(_mutex);
+	if (_renderCache && _renderCache->replayStopped())
+		restoreChannelState();
 	_service.renderBit16s(data, len);
 }
 
@@ -189,6 +189,8 @@ void OPL::reset() {
 }
 
 void OPL::write(int port, int val) {
+	cacheWrite(port, val);
+
 	if (port&1) {
 		switch (_type) {
 		case Config::kOpl2:
@@ -69,6 +69,7 @@ void OPL::reset() {
 }
 
 void OPL::write(int a, int v) {
+	cacheWrite(a, v);
 	MAME::OPLWrite(_opl, a, v);
 }
 
@@ -77,6 +78,7 @@ byte OPL::read(int a) {
 }
 
 void OPL::writeReg(int r, int v) {
+	cacheWriteReg(r, v);
 	MAME::OPLWriteReg(_opl, r, v);
 }
 
@@ -379,6 +379,12 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
     Bit8u reset = 0;
     slot->eg_out = slot->eg_rout + (slot->reg_tl << 2)
                  + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + *slot->trem;
+    // Released and fully decayed slots stay where they are until keyed on
+    if (!slot->key && slot->eg_gen == envelope_gen_num_release && slot->eg_rout == 0x1ff)
+    {
+        slot->pg_reset = 0;
+        return;
+    }
     if (slot->key && slot->eg_gen == envelope_gen_num_release)
     {
         reset = 1;
@@ -671,8 +677,31 @@ static void OPL3_SlotWriteE0(opl3_slot *slot, Bit8u data)
     }
 }
 
+// Once the attenuation reaches 0x180 the exp table output is shifted out
+// completely, so only the sign of the waveform remains.
+static Bit16s OPL3_EnvelopeCalcSilent(Bit8u wf, Bit16u phase)
+{
+    phase &= 0x3ff;
+    switch (wf)
+    {
+    case 0:
+    case 6:
+    case 7:
+        return (phase & 0x200) ? -1 : 0;
+    case 4:
+        return ((phase & 0x300) == 0x100) ? -1 : 0;
+    default:
+        return 0;
+    }
+}
+
 static void OPL3_SlotGenerate(opl3_slot *slot)
 {
+    if (slot->eg_out >= 0x180)
+    {
+        slot->out = OPL3_EnvelopeCalcSilent(slot->reg_wf, slot->pg_phase_out + *slot->mod);
+        return;
+    }
     slot->out = envelope_sin[slot->reg_wf](slot->pg_phase_out + *slot->mod, slot->eg_out);
 }
 
@@ -1422,6 +1451,8 @@ void OPL::reset() {
 }
 
 void OPL::write(int port, int val) {
+	cacheWrite(port, val);
+
 	if (port & 1) {
 		switch (_type) {
 		case Config::kOpl2:
@@ -1470,6 +1501,7 @@ void OPL::write(int port, int val) {
 
 
 void OPL::writeReg(int r, int v) {
+	cacheWriteReg(r, v);
 	OPL3_WriteRegBuffered(&chip, (Bit16u)r, (Bit8u)v);
 }
 
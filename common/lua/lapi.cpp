@@ -1013,6 +1013,14 @@ LUA_API void lua_setallocf (lua_State *L, lua_Alloc f, void *ud) {
 }
 
 
+LUA_API void lua_setgchook (lua_State *L, lua_GCHook f, void *ud) {
+  lua_lock(L);
+  G(L)->gchook = f;
+  G(L)->gchookud = ud;
+  lua_unlock(L);
+}
+
+
 LUA_API void *lua_newuserdata (lua_State *L, size_t size) {
   Udata *u;
   lua_lock(L);
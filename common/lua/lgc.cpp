@@ -631,6 +631,17 @@ void luaC_step (lua_State *L) {
 }
 
 
+/* a step triggered by allocations, reported to the GC hook */
+void luaC_autostep (lua_State *L) {
+  global_State *g = G(L);
+  if (g->gchook)
+    g->gchook(g->gchookud, 1);
+  luaC_step(L);
+  if (g->gchook)
+    g->gchook(g->gchookud, 0);
+}
+
+
 void luaC_fullgc (lua_State *L) {
   global_State *g = G(L);
   if (g->gcstate <= GCSpropagate) {
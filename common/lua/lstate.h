@@ -86,6 +86,8 @@ typedef struct global_State {
   int gcpause;  /* size of pause between successive GCs */
   int gcstepmul;  /* GC `granularity' */
   lua_CFunction panic;  /* to be called in unprotected errors */
+  lua_GCHook gchook;  /* to be called around automatic collector steps */
+  void *gchookud;   /* auxiliary data to `gchook' */
   TValue l_registry;
   struct lua_State *mainthread;
   UpVal uvhead;  /* head of double-linked list of all open upvalues */
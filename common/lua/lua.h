@@ -244,6 +244,15 @@ LUA_API void  (lua_concat) (lua_State *L, int n);
 LUA_API lua_Alloc (lua_getallocf) (lua_State *L, void **ud);
 LUA_API void lua_setallocf (lua_State *L, lua_Alloc f, void *ud);
 
+/*
+** Added in ScummVM: called before (start = 1) and after (start = 0)
+** every collector step triggered by allocations. It must not call
+** back into Lua.
+*/
+typedef void (*lua_GCHook) (void *ud, int start);
+
+LUA_API void lua_setgchook (lua_State *L, lua_GCHook f, void *ud);
+
 
 
 /*
@@ -22,7 +22,7 @@
 
 #include "bladerunner/aud_stream.h"
 
-#include "bladerunner/audio_cache.h"
+#include "bladerunner/resource_cache.h"
 
 #include "common/util.h"
 
@@ -36,16 +36,14 @@ AudStream::AudStream(byte *data, int overrideFrequency) {
 	init(data);
 }
 
-AudStream::AudStream(AudioCache *cache, int32 hash, int overrideFrequency) {
+AudStream::AudStream(ResourceCache *cache, int32 hash, int overrideFrequency) {
 	assert(cache != nullptr);
 
 	_cache = cache;
 	_hash  = hash;
 	_overrideFrequency = overrideFrequency;
 
-	_cache->incRef(_hash);
-
-	init(_cache->findByHash(_hash));
+	init(_cache->incRef(kResourceCacheAudio, _hash));
 }
 
 void AudStream::init(byte *data) {
@@ -65,7 +63,7 @@ void AudStream::init(byte *data) {
 
 AudStream::~AudStream() {
 	if (_cache) {
-		_cache->decRef(_hash);
+		_cache->decRef(kResourceCacheAudio, _hash);
 	}
 }
 
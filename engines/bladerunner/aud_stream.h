@@ -31,21 +31,21 @@
 
 namespace BladeRunner {
 
-class AudioCache;
+class ResourceCache;
 
 class AudStream : public Audio::RewindableAudioStream {
-	byte       *_data;
-	byte       *_p;
-	byte       *_end;
-	AudioCache *_cache;
-	int32       _hash;
-	uint16      _deafBlockRemain;
-	uint16      _frequency;
-	uint32      _size;
-	uint32      _sizeDecompressed;
-	byte        _flags;
-	byte        _compressionType;
-	int         _overrideFrequency;
+	byte          *_data;
+	byte          *_p;
+	byte          *_end;
+	ResourceCache *_cache;
+	int32         _hash;
+	uint16        _deafBlockRemain;
+	uint16        _frequency;
+	uint32        _size;
+	uint32        _sizeDecompressed;
+	byte          _flags;
+	byte          _compressionType;
+	int           _overrideFrequency;
 
 	ADPCMWestwoodDecoder _decoder;
 
@@ -53,7 +53,7 @@ class AudStream : public Audio::RewindableAudioStream {
 
 public:
 	AudStream(byte *data, int overrideFrequency = -1);
-	AudStream(AudioCache *cache, int32 hash, int overrideFrequency = -1);
+	AudStream(ResourceCache *cache, int32 hash, int overrideFrequency = -1);
 	~AudStream() override;
 
 	int readBuffer(int16 *buffer, const int numSamples) override;
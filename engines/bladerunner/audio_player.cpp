@@ -24,9 +24,9 @@
 
 #include "bladerunner/archive.h"
 #include "bladerunner/aud_stream.h"
-#include "bladerunner/audio_cache.h"
 #include "bladerunner/audio_mixer.h"
 #include "bladerunner/bladerunner.h"
+#include "bladerunner/resource_cache.h"
 
 #include "common/debug.h"
 #include "common/stream.h"
@@ -168,7 +168,7 @@ int AudioPlayer::playAud(const Common::String &name, int volume, int panStart, i
 
 	/* Load audio resource and store in cache. Playback will happen directly from there. */
 	int32 hash = MIXArchive::getHash(name);
-	if (!_vm->_audioCache->findByHash(hash)) {
+	if (!_vm->_resourceCache->find(kResourceCacheAudio, hash)) {
 		Common::SeekableReadStream *r = _vm->getResourceStream(name);
 		if (!r) {
 			//debug ("Could not get stream for %s %d - giving up", name.c_str(), priority);
@@ -176,18 +176,16 @@ int AudioPlayer::playAud(const Common::String &name, int volume, int panStart, i
 		}
 
 		int32 size = r->size();
-		while (!_vm->_audioCache->canAllocate(size)) {
-			if (!_vm->_audioCache->dropOldest()) {
-				delete r;
-				//debug ("No available mem in cache for %s %d - giving up", name.c_str(), priority);
-				return -1;
-			}
+		if (!_vm->_resourceCache->makeRoom(size)) {
+			delete r;
+			//debug ("No available mem in cache for %s %d - giving up", name.c_str(), priority);
+			return -1;
 		}
-		_vm->_audioCache->storeByHash(hash, r);
+		_vm->_resourceCache->store(kResourceCacheAudio, hash, r);
 		delete r;
 	}
 
-	AudStream *audioStream = new AudStream(_vm->_audioCache, hash);
+	AudStream *audioStream = new AudStream(_vm->_resourceCache, hash);
 
 	int actualVolume = volume;
 	if (!(flags & kAudioPlayerOverrideVolume)) {
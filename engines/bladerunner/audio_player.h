@@ -33,7 +33,6 @@
 namespace BladeRunner {
 
 class BladeRunnerEngine;
-class AudioCache;
 class AudStream;
 
 enum AudioPlayerFlags {
@@ -25,7 +25,6 @@
 #include "bladerunner/actor.h"
 #include "bladerunner/actor_dialogue_queue.h"
 #include "bladerunner/ambient_sounds.h"
-#include "bladerunner/audio_cache.h"
 #include "bladerunner/audio_mixer.h"
 #include "bladerunner/audio_player.h"
 #include "bladerunner/audio_speech.h"
@@ -48,6 +47,7 @@
 #include "bladerunner/obstacles.h"
 #include "bladerunner/overlays.h"
 #include "bladerunner/regions.h"
+#include "bladerunner/resource_cache.h"
 #include "bladerunner/savefile.h"
 #include "bladerunner/scene.h"
 #include "bladerunner/scene_objects.h"
@@ -187,7 +187,7 @@ BladeRunnerEngine::BladeRunnerEngine(OSystem *syst, const ADGameDescription *des
 	_sceneObjects            = nullptr;
 	_gameFlags               = nullptr;
 	_items                   = nullptr;
-	_audioCache              = nullptr;
+	_resourceCache           = nullptr;
 	_audioMixer              = nullptr;
 	_audioPlayer             = nullptr;
 	_music                   = nullptr;
@@ -589,7 +589,7 @@ bool BladeRunnerEngine::startup(bool hasSavegames) {
 
 	_items = new Items(this);
 
-	_audioCache = new AudioCache();
+	_resourceCache = new ResourceCache();
 
 	_audioMixer = new AudioMixer(this);
 
@@ -930,8 +930,8 @@ void BladeRunnerEngine::shutdown() {
 	delete _audioMixer;
 	_audioMixer = nullptr;
 
-	delete _audioCache;
-	_audioCache = nullptr;
+	delete _resourceCache;
+	_resourceCache = nullptr;
 
 	delete _items;
 	_items = nullptr;
@@ -62,7 +62,6 @@ class ActorDialogueQueue;
 class ScreenEffects;
 class AIScripts;
 class AmbientSounds;
-class AudioCache;
 class AudioMixer;
 class AudioPlayer;
 class AudioSpeech;
@@ -87,6 +86,7 @@ class Music;
 class Obstacles;
 class Overlays;
 class PoliceMaze;
+class ResourceCache;
 class Scene;
 class SceneObjects;
 class SceneScript;
@@ -134,7 +134,6 @@ public:
 	ScreenEffects      *_screenEffects;
 	AIScripts          *_aiScripts;
 	AmbientSounds      *_ambientSounds;
-	AudioCache         *_audioCache;
 	AudioMixer         *_audioMixer;
 	AudioPlayer        *_audioPlayer;
 	AudioSpeech        *_audioSpeech;
@@ -158,6 +157,7 @@ public:
 	Obstacles          *_obstacles;
 	Overlays           *_overlays;
 	PoliceMaze         *_policeMaze;
+	ResourceCache      *_resourceCache;
 	Scene              *_scene;
 	SceneObjects       *_sceneObjects;
 	SceneScript        *_sceneScript;
@@ -34,6 +34,7 @@
 #include "bladerunner/light.h"
 #include "bladerunner/lights.h"
 #include "bladerunner/regions.h"
+#include "bladerunner/resource_cache.h"
 #include "bladerunner/savefile.h"
 #include "bladerunner/scene.h"
 #include "bladerunner/scene_objects.h"
@@ -63,8 +64,10 @@
 #include "bladerunner/subtitles.h"
 
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/str.h"
+#include "common/system.h"
 
 #include "graphics/surface.h"
 
@@ -134,6 +137,8 @@ Debugger::Debugger(BladeRunnerEngine *vm) : GUI::Debugger() {
 	registerCmd("region", WRAP_METHOD(Debugger, cmdRegion));
 	registerCmd("click", WRAP_METHOD(Debugger, cmdClick));
 	registerCmd("difficulty", WRAP_METHOD(Debugger, cmdDifficulty));
+	registerCmd("slicebench", WRAP_METHOD(Debugger, cmdSliceBench));
+	registerCmd("cache", WRAP_METHOD(Debugger, cmdCache));
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	registerCmd("effect", WRAP_METHOD(Debugger, cmdEffect));
@@ -1840,6 +1845,91 @@ bool Debugger::cmdDifficulty(int argc, const char **argv) {
 	}
 	return true;
 }
+
+/**
+* Render the actors of the current set repeatedly into a scratch copy of the frame
+* and report how long the slice renderer took. The number of drawn actors is scaled up
+* by cycling through the actors present in the set.
+*/
+bool Debugger::cmdSliceBench(int argc, const char **argv) {
+	if (argc != 2 && argc != 3) {
+		debugPrintf("Benchmark slice rendering of the actors in the current set.\n");
+		debugPrintf("Usage: %s <actorCount> [<iterations>]\n", argv[0]);
+		return true;
+	}
+
+	int actorCount = atoi(argv[1]);
+	int iterations = argc == 3 ? atoi(argv[2]) : 10;
+	if (actorCount <= 0 || iterations <= 0) {
+		debugPrintf("Actor count and iterations must be positive\n");
+		return true;
+	}
+
+	Common::Array<Actor *> actors;
+	int setId = _vm->_scene->getSetId();
+	for (int i = 0; i < (int)_vm->_gameInfo->getActorCount(); ++i) {
+		Actor *actor = _vm->_actors[i];
+		if (actor != nullptr && actor->getSetId() == setId && actor->getAnimationId() >= 0) {
+			actors.push_back(actor);
+		}
+	}
+
+	if (actors.empty()) {
+		debugPrintf("There are no actors in the current set\n");
+		return true;
+	}
+
+	// Keep the current frame and z-buffer intact, the benchmark draws over them
+	Graphics::Surface frontCopy;
+	frontCopy.copyFrom(_vm->_surfaceFront);
+	const uint zbufferSize = 640 * 480;
+	uint16 *zbufferCopy = new uint16[zbufferSize];
+	memcpy(zbufferCopy, _vm->_zbuffer->getData(), zbufferSize * sizeof(uint16));
+
+	uint32 startTime = g_system->getMillis(true);
+	for (int i = 0; i < iterations; ++i) {
+		memcpy(_vm->_zbuffer->getData(), zbufferCopy, zbufferSize * sizeof(uint16));
+		for (int j = 0; j < actorCount; ++j) {
+			Common::Rect screenRect;
+			actors[j % actors.size()]->draw(&screenRect);
+		}
+	}
+	uint32 elapsedTime = g_system->getMillis(true) - startTime;
+
+	blit(frontCopy, _vm->_surfaceFront);
+	memcpy(_vm->_zbuffer->getData(), zbufferCopy, zbufferSize * sizeof(uint16));
+	frontCopy.free();
+	delete[] zbufferCopy;
+
+	debugPrintf("Drew %i actors (%i distinct) %i times in %u ms, %.2f ms per frame\n",
+	            actorCount, (int)actors.size(), iterations, elapsedTime, (float)elapsedTime / iterations);
+	return true;
+}
+
+/**
+* Show usage and hit/miss statistics of the resource cache
+*/
+bool Debugger::cmdCache(int argc, const char **argv) {
+	if (argc != 1) {
+		debugPrintf("Show resource cache statistics.\n");
+		debugPrintf("Usage: %s\n", argv[0]);
+		return true;
+	}
+
+	static const char *typeNames[kResourceCacheTypeCount] = { "audio", "slice pages", "shapes" };
+
+	ResourceCache *cache = _vm->_resourceCache;
+	debugPrintf("Resource cache uses %u of %u bytes\n", cache->getTotalSize(), cache->getMaxSize());
+	for (int i = 0; i < kResourceCacheTypeCount; ++i) {
+		ResourceCache::Stats stats = cache->getStats((ResourceCacheType)i);
+		uint32 lookups = stats.hits + stats.misses;
+		debugPrintf("%-12s: %4u items, %9u bytes, %6u hits, %6u misses (%3u%% hit rate), %6u evictions\n",
+		            typeNames[i], stats.itemCount, stats.totalSize, stats.hits, stats.misses,
+		            lookups > 0 ? stats.hits * 100 / lookups : 0, stats.evictions);
+	}
+	return true;
+}
+
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 bool Debugger::cmdEffect(int argc, const char **argv) {
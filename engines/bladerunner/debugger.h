@@ -114,6 +114,8 @@ public:
 	bool cmdRegion(int argc, const char **argv);
 	bool cmdClick(int argc, const char **argv);
 	bool cmdDifficulty(int argc, const char **argv);
+	bool cmdSliceBench(int argc, const char **argv);
+	bool cmdCache(int argc, const char **argv);
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	bool cmdEffect(int argc, const char **argv);
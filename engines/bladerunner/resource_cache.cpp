@@ -0,0 +1,210 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "bladerunner/resource_cache.h"
+
+#include "common/stream.h"
+
+namespace BladeRunner {
+
+ResourceCache::ResourceCache(uint32 maxSize) :
+	_head(nullptr),
+	_tail(nullptr),
+	_totalSize(0),
+	_maxSize(maxSize) {
+	memset(_stats, 0, sizeof(_stats));
+}
+
+ResourceCache::~ResourceCache() {
+	Item *item = _head;
+	while (item) {
+		Item *next = item->next;
+		free(item->data);
+		delete item;
+		item = next;
+	}
+}
+
+bool ResourceCache::makeRoom(uint32 size) {
+	Common::StackLock lock(_mutex);
+
+	if (size > _maxSize) {
+		return false;
+	}
+
+	while (_totalSize > _maxSize - size) {
+		if (!dropLeastRecent()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+byte *ResourceCache::find(ResourceCacheType type, int32 id, uint32 *size) {
+	Common::StackLock lock(_mutex);
+
+	Item *item = findItem(type, id);
+	if (!item) {
+		++_stats[type].misses;
+		return nullptr;
+	}
+
+	++_stats[type].hits;
+	if (item != _head) {
+		detach(item);
+		attachHead(item);
+	}
+
+	if (size) {
+		*size = item->size;
+	}
+	return item->data;
+}
+
+byte *ResourceCache::store(ResourceCacheType type, int32 id, Common::SeekableReadStream *stream) {
+	uint32 size = stream->size();
+	byte *data = (byte *)malloc(size);
+	stream->read(data, size);
+
+	return store(type, id, data, size);
+}
+
+byte *ResourceCache::store(ResourceCacheType type, int32 id, byte *data, uint32 size) {
+	Common::StackLock lock(_mutex);
+
+	assert(!findItem(type, id));
+
+	// Make room if possible, but do not refuse the resource
+	// when everything left in the cache is in use
+	while (_totalSize + size > _maxSize) {
+		if (!dropLeastRecent()) {
+			break;
+		}
+	}
+
+	Item *item = new Item();
+	item->type = type;
+	item->id   = id;
+	item->refs = 0;
+	item->data = data;
+	item->size = size;
+
+	_items[type][id] = item;
+	attachHead(item);
+
+	_totalSize += size;
+	++_stats[type].itemCount;
+	_stats[type].totalSize += size;
+
+	return data;
+}
+
+byte *ResourceCache::incRef(ResourceCacheType type, int32 id) {
+	Common::StackLock lock(_mutex);
+
+	Item *item = findItem(type, id);
+	assert(item && "ResourceCache::incRef: id not found");
+
+	++(item->refs);
+	return item->data;
+}
+
+void ResourceCache::decRef(ResourceCacheType type, int32 id) {
+	Common::StackLock lock(_mutex);
+
+	Item *item = findItem(type, id);
+	assert(item && "ResourceCache::decRef: id not found");
+	assert(item->refs > 0);
+
+	--(item->refs);
+}
+
+uint32 ResourceCache::getTotalSize() const {
+	Common::StackLock lock(_mutex);
+
+	return _totalSize;
+}
+
+ResourceCache::Stats ResourceCache::getStats(ResourceCacheType type) {
+	Common::StackLock lock(_mutex);
+
+	return _stats[type];
+}
+
+ResourceCache::Item *ResourceCache::findItem(ResourceCacheType type, int32 id) const {
+	ItemMap::const_iterator it = _items[type].find(id);
+	if (it == _items[type].end()) {
+		return nullptr;
+	}
+	return it->_value;
+}
+
+void ResourceCache::attachHead(Item *item) {
+	item->prev = nullptr;
+	item->next = _head;
+	if (_head) {
+		_head->prev = item;
+	} else {
+		_tail = item;
+	}
+	_head = item;
+}
+
+void ResourceCache::detach(Item *item) {
+	if (item->prev) {
+		item->prev->next = item->next;
+	} else {
+		_head = item->next;
+	}
+	if (item->next) {
+		item->next->prev = item->prev;
+	} else {
+		_tail = item->prev;
+	}
+	item->prev = nullptr;
+	item->next = nullptr;
+}
+
+bool ResourceCache::dropLeastRecent() {
+	Item *item = _tail;
+	while (item && item->refs > 0) {
+		item = item->prev;
+	}
+
+	if (!item) {
+		return false;
+	}
+
+	detach(item);
+	_items[item->type].erase(item->id);
+
+	_totalSize -= item->size;
+	++_stats[item->type].evictions;
+	--_stats[item->type].itemCount;
+	_stats[item->type].totalSize -= item->size;
+
+	free(item->data);
+	delete item;
+	return true;
+}
+
+} // End of namespace BladeRunner
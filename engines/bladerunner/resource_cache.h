@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BLADERUNNER_RESOURCE_CACHE_H
+#define BLADERUNNER_RESOURCE_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/mutex.h"
+
+namespace Common {
+class SeekableReadStream;
+}
+
+namespace BladeRunner {
+
+enum ResourceCacheType {
+	kResourceCacheAudio     = 0,
+	kResourceCacheSlicePage = 1,
+	kResourceCacheShapes    = 2,
+	kResourceCacheTypeCount = 3
+};
+
+/*
+ * An imitation of Bladerunner's resource cache.
+ *
+ * Resources are kept in memory until the total size exceeds the budget,
+ * at which point the least recently used resources without references are dropped.
+ */
+class ResourceCache {
+	struct Item {
+		ResourceCacheType type;
+		int32             id;
+		int               refs;
+		byte             *data;
+		uint32            size;
+
+		// Intrusive LRU list, head is the most recently used item
+		Item *prev;
+		Item *next;
+	};
+
+	typedef Common::HashMap<int32, Item *> ItemMap;
+
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+		uint32 itemCount;
+		uint32 totalSize;
+	};
+
+	static const uint32 kDefaultMaxSize = 32 * 1024 * 1024;
+
+private:
+	Common::Mutex _mutex;
+	ItemMap       _items[kResourceCacheTypeCount];
+	Stats         _stats[kResourceCacheTypeCount];
+
+	Item *_head;
+	Item *_tail;
+
+	uint32 _totalSize;
+	uint32 _maxSize;
+
+public:
+	ResourceCache(uint32 maxSize = kDefaultMaxSize);
+	~ResourceCache();
+
+	bool  makeRoom(uint32 size);
+
+	byte *find(ResourceCacheType type, int32 id, uint32 *size = nullptr);
+	byte *store(ResourceCacheType type, int32 id, Common::SeekableReadStream *stream);
+	byte *store(ResourceCacheType type, int32 id, byte *data, uint32 size);
+
+	byte *incRef(ResourceCacheType type, int32 id);
+	void  decRef(ResourceCacheType type, int32 id);
+
+	uint32 getTotalSize() const;
+	uint32 getMaxSize() const { return _maxSize; }
+	Stats  getStats(ResourceCacheType type);
+
+private:
+	Item *findItem(ResourceCacheType type, int32 id) const;
+	void  attachHead(Item *item);
+	void  detach(Item *item);
+	bool  dropLeastRecent();
+};
+
+} // End of namespace BladeRunner
+
+#endif
@@ -22,9 +22,12 @@
 
 #include "bladerunner/shape.h"
 
+#include "bladerunner/archive.h"
 #include "bladerunner/bladerunner.h"
+#include "bladerunner/resource_cache.h"
 
 #include "common/debug.h"
+#include "common/memstream.h"
 #include "common/ptr.h"
 #include "common/util.h"
 
@@ -32,7 +35,7 @@
 
 namespace BladeRunner {
 
-bool Shape::load(Common::SeekableReadStream *stream) {
+bool Shape::load(Common::SeekableReadStream *stream, const byte *containerData) {
 	_width = stream->readUint32LE();
 	_height = stream->readUint32LE();
 	uint32 size = stream->readUint32LE();
@@ -47,18 +50,15 @@ bool Shape::load(Common::SeekableReadStream *stream) {
 		warning("Shape::load shape too big (%d, %d)", _width, _height);
 	}
 
-	_data = new byte[size];
-
-	if (stream->read(_data, size) != size) {
+	if (stream->size() - stream->pos() < (int32)size) {
 		warning("Shape::load error reading shape (w %d, h %d, sz %d)", _width, _height, size);
 		return false;
 	}
 
-	return true;
-}
+	_data = containerData + stream->pos();
+	stream->skip(size);
 
-Shape::~Shape() {
-	delete[] _data;
+	return true;
 }
 
 void Shape::draw(Graphics::Surface &surface, int x, int y) const {
@@ -97,6 +97,8 @@ void Shape::draw(Graphics::Surface &surface, int x, int y) const {
 
 Shapes::Shapes(BladeRunnerEngine *vm) {
 	_vm = vm;
+	_containerHash = 0;
+	_isContainerReferenced = false;
 }
 
 Shapes::~Shapes() {
@@ -106,18 +108,30 @@ Shapes::~Shapes() {
 bool Shapes::load(const Common::String &container) {
 	unload();
 
-	Common::ScopedPtr<Common::SeekableReadStream> stream(_vm->getResourceStream(container));
-	if (!stream) {
-		warning("Shape::open failed to open '%s'", container.c_str());
-		return false;
+	int32 hash = MIXArchive::getHash(container);
+	uint32 size = 0;
+	if (!_vm->_resourceCache->find(kResourceCacheShapes, hash, &size)) {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(_vm->getResourceStream(container));
+		if (!stream) {
+			warning("Shape::open failed to open '%s'", container.c_str());
+			return false;
+		}
+		size = stream->size();
+		_vm->_resourceCache->store(kResourceCacheShapes, hash, stream.get());
 	}
 
-	uint32 count = stream->readUint32LE();
+	const byte *data = _vm->_resourceCache->incRef(kResourceCacheShapes, hash);
+	_containerHash = hash;
+	_isContainerReferenced = true;
+
+	Common::MemoryReadStream stream(data, size);
+
+	uint32 count = stream.readUint32LE();
 
 	_shapes.resize(count);
 
 	for (uint32 i = 0; i < count; ++i) {
-		if (!_shapes[i].load(stream.get())) {
+		if (!_shapes[i].load(&stream, data)) {
 			return false;
 		}
 	}
@@ -127,6 +141,11 @@ bool Shapes::load(const Common::String &container) {
 
 void Shapes::unload() {
 	_shapes.clear();
+
+	if (_isContainerReferenced) {
+		_vm->_resourceCache->decRef(kResourceCacheShapes, _containerHash);
+		_isContainerReferenced = false;
+	}
 }
 
 
@@ -42,14 +42,14 @@ class BladeRunnerEngine;
 class Shape {
 	friend class Shapes;
 
-	int   _width;
-	int   _height;
-	byte *_data;
+	int         _width;
+	int         _height;
+	const byte *_data;
 
-	bool load(Common::SeekableReadStream *stream);
+	bool load(Common::SeekableReadStream *stream, const byte *containerData);
 
 public:
-	~Shape();
+	Shape() : _width(0), _height(0), _data(nullptr) {}
 
 	void draw(Graphics::Surface &surface, int x, int y) const;
 
@@ -62,6 +62,10 @@ class Shapes {
 
 	Common::Array<Shape> _shapes;
 
+	// The shape pixels point directly into the container held by the resource cache
+	int32 _containerHash;
+	bool  _isContainerReferenced;
+
 public:
 	Shapes(BladeRunnerEngine *vm);
 	~Shapes();
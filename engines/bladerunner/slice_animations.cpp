@@ -23,7 +23,7 @@
 #include "bladerunner/slice_animations.h"
 
 #include "bladerunner/bladerunner.h"
-#include "bladerunner/time.h"
+#include "bladerunner/resource_cache.h"
 
 #include "common/debug.h"
 #include "common/file.h"
@@ -77,17 +77,10 @@ bool SliceAnimations::open(const Common::String &name) {
 		_animations[i].offset           = file.readUint32LE();
 	}
 
-	_pages.resize(_pageCount);
-	for (uint32 i = 0; i != _pageCount; ++i)
-		_pages[i]._data = nullptr;
-
 	return true;
 }
 
 SliceAnimations::~SliceAnimations() {
-	for (uint32 i = 0; i != _pages.size(); ++i)
-		free(_pages[i]._data);
-
 	// close open files
 	_coreAnimPageFile.close(0);
 	if (!_vm->_cutContent) {
@@ -220,8 +213,6 @@ void *SliceAnimations::PageFile::loadPage(uint32 pageNumber) {
 
 	uint32 pageSize = _sliceAnimations->_pageSize;
 
-	// TODO: Retire oldest pages if we exceed some memory limit
-
 	void *data = malloc(pageSize);
 	_files[_pageOffsetsFileIdx[pageNumber]].seek(_pageOffsets[pageNumber], SEEK_SET);
 	uint32 r = _files[_pageOffsetsFileIdx[pageNumber]].read(data, pageSize);
@@ -258,21 +249,24 @@ void *SliceAnimations::getFramePtr(uint32 animation, uint32 frame) {
 	uint32 page        = frameOffset / _pageSize;
 	uint32 pageOffset  = frameOffset % _pageSize;
 
-	if (_pages[page]._data == nullptr) {                          // if not cached already
-		_pages[page]._data = _coreAnimPageFile.loadPage(page);    // look in COREANIM first
+	// Pages are owned by the resource cache and can be evicted at any later lookup,
+	// so the returned pointer is only valid until the next call
+	byte *data = _vm->_resourceCache->find(kResourceCacheSlicePage, page);
+	if (data == nullptr) {                                  // if not cached already
+		void *pageData = _coreAnimPageFile.loadPage(page);  // look in COREANIM first
 
-		if (_pages[page]._data == nullptr) {                      // if not in COREAMIM
-			_pages[page]._data = _framesPageFile.loadPage(page);  // Look in CDFRAMES or HDFRAMES loaded data
+		if (pageData == nullptr) {                          // if not in COREAMIM
+			pageData = _framesPageFile.loadPage(page);      // Look in CDFRAMES or HDFRAMES loaded data
 
-			if (_pages[page]._data == nullptr) {
+			if (pageData == nullptr) {
 				error("Unable to locate page %d for animation %d frame %d", page, animation, frame);
 			}
 		}
-	}
 
-	_pages[page]._lastAccess = _vm->_time->currentSystem();
+		data = _vm->_resourceCache->store(kResourceCacheSlicePage, page, (byte *)pageData, _pageSize);
+	}
 
-	return (byte *)_pages[page]._data + pageOffset;
+	return data + pageOffset;
 }
 
 Vector3 SliceAnimations::getPositionChange(int animation) const {
@@ -56,13 +56,6 @@ class SliceAnimations {
 	//	uint16 &operator[](size_t i) { return color555[i]; }
 	};
 
-	struct Page {
-		void   *_data;
-		uint32 _lastAccess;
-
-		Page() : _data(nullptr), _lastAccess(0) {}
-	};
-
 	struct PageFile {
 		int                  _fileNumber;
 		SliceAnimations     *_sliceAnimations;
@@ -86,7 +79,6 @@ class SliceAnimations {
 
 	Common::Array<Palette>      _palettes;
 	Common::Array<Animation>    _animations;
-	Common::Array<Page>         _pages;
 
 	PageFile _coreAnimPageFile;
 	PageFile _framesPageFile;
@@ -554,6 +554,12 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 	uint32 polyCount = READ_LE_UINT32(p);
 	p += 4;
 
+	// The destination line and clipping bounds are the same for every span of the slice,
+	// so resolve them once instead of per pixel
+	byte *linePtr = (byte *)surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+	const int bytesPerPixel = surface.format.bytesPerPixel;
+	const int maxX = surface.w - 1;
+
 	while (polyCount--) {
 		uint32 vertexCount = READ_LE_UINT32(p);
 		p += 4;
@@ -587,11 +593,12 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						outColor = _pixelFormat.RGBToColor(CLIP(color.r * bladeToScummVmConstant, 0, 255), CLIP(color.g * bladeToScummVmConstant, 0, 255), CLIP(color.b * bladeToScummVmConstant, 0, 255));
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
-						if (vertexZ < zbufferLine[x]) {
-							zbufferLine[x] = (uint16)vertexZ;
+					uint16 *zPtr = zbufferLine + previousVertexX;
+					for (int x = previousVertexX; x != vertexX; ++x, ++zPtr) {
+						if (vertexZ < *zPtr) {
+							*zPtr = (uint16)vertexZ;
 
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
+							void *dstPtr = linePtr + CLIP(x, 0, maxX) * bytesPerPixel;
 							drawPixel(surface, dstPtr, outColor);
 						}
 					}
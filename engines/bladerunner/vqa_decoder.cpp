@@ -143,6 +143,9 @@ VQADecoder::~VQADecoder() {
 	for (uint i = 0; i < _codebooks.size(); ++i) {
 		delete[] _codebooks[i].data;
 	}
+	for (int i = 0; i < kFramePacketCacheSize; ++i) {
+		delete[] _framePackets[i].data;
+	}
 	delete _audioTrack;
 	delete _videoTrack;
 	delete[] _frameInfo;
@@ -221,34 +224,34 @@ void VQADecoder::decodeLights(Lights *lights) {
 	_videoTrack->decodeLights(lights);
 }
 
-void VQADecoder::readPacket(uint readFlags) {
+void VQADecoder::readPacket(Common::SeekableReadStream *s, uint readFlags) {
 	IFFChunkHeader chd;
 
-	if (remain(_s) < 8) {
-		warning("VQADecoder::readPacket(): remain: %d", remain(_s));
-		assert(remain(_s) < 8);
+	if (remain(s) < 8) {
+		warning("VQADecoder::readPacket(): remain: %d", remain(s));
+		assert(remain(s) < 8);
 	}
 
 	do {
-		if (!readIFFChunkHeader(_s, &chd)) {
+		if (!readIFFChunkHeader(s, &chd)) {
 			error("VQADecoder::readPacket(): Error reading chunk header");
 		}
 
 		bool rc = false;
 		// Video track
 		switch (chd.id) {
-		case kAESC: rc = ((readFlags & kVQAReadCustom) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readAESC(_s, chd.size); break;
-		case kLITE: rc = ((readFlags & kVQAReadCustom) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readLITE(_s, chd.size); break;
-		case kVIEW: rc = ((readFlags & kVQAReadCustom) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readVIEW(_s, chd.size); break;
-		case kVQFL: rc = ((readFlags & kVQAReadVideo ) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readVQFL(_s, chd.size, readFlags); break;
-		case kVQFR: rc = ((readFlags & kVQAReadVideo ) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readVQFR(_s, chd.size, readFlags); break;
-		case kZBUF: rc = ((readFlags & kVQAReadCustom) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readZBUF(_s, chd.size); break;
+		case kAESC: rc = ((readFlags & kVQAReadCustom) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readAESC(s, chd.size); break;
+		case kLITE: rc = ((readFlags & kVQAReadCustom) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readLITE(s, chd.size); break;
+		case kVIEW: rc = ((readFlags & kVQAReadCustom) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readVIEW(s, chd.size); break;
+		case kVQFL: rc = ((readFlags & kVQAReadVideo ) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readVQFL(s, chd.size, readFlags); break;
+		case kVQFR: rc = ((readFlags & kVQAReadVideo ) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readVQFR(s, chd.size, readFlags); break;
+		case kZBUF: rc = ((readFlags & kVQAReadCustom) == 0) ? s->skip(roundup(chd.size)) : _videoTrack->readZBUF(s, chd.size); break;
 		// Sound track
-		case kSN2J: rc = ((readFlags & kVQAReadAudio) == 0) ? _s->skip(roundup(chd.size)) : _audioTrack->readSN2J(_s, chd.size); break;
-		case kSND2: rc = ((readFlags & kVQAReadAudio) == 0) ? _s->skip(roundup(chd.size)) : _audioTrack->readSND2(_s, chd.size); break;
+		case kSN2J: rc = ((readFlags & kVQAReadAudio) == 0) ? s->skip(roundup(chd.size)) : _audioTrack->readSN2J(s, chd.size); break;
+		case kSND2: rc = ((readFlags & kVQAReadAudio) == 0) ? s->skip(roundup(chd.size)) : _audioTrack->readSND2(s, chd.size); break;
 		default:
 			rc = false;
-			_s->skip(roundup(chd.size));
+			s->skip(roundup(chd.size));
 		}
 
 		if (!rc) {
@@ -263,11 +266,72 @@ void VQADecoder::readFrame(int frame, uint readFlags) {
 		error("VQADecoder::readFrame(): frame %d out of bounds, frame count is %d", frame, numFrames());
 	}
 
-	uint32 frameOffset = 2 * (_frameInfo[frame] & 0x0FFFFFFF);
-	_s->seek(frameOffset);
-
 	_readingFrame = frame;
-	readPacket(readFlags);
+
+	FramePacket *packet = fetchFramePacket(frame);
+	if (packet) {
+		Common::MemoryReadStream s(packet->data, packet->size);
+		readPacket(&s, readFlags);
+	} else {
+		_s->seek(frameOffset(frame));
+		readPacket(_s, readFlags);
+	}
+}
+
+uint32 VQADecoder::frameOffset(int frame) const {
+	return 2 * (_frameInfo[frame] & 0x0FFFFFFF);
+}
+
+uint32 VQADecoder::framePacketSize(int frame) const {
+	uint32 begin = frameOffset(frame);
+	uint32 end = (frame + 1 < numFrames()) ? frameOffset(frame + 1) : (uint32)_s->size();
+
+	// Packets are expected to follow each other in the stream, anything else is read directly
+	if (end <= begin || end - begin > kFramePacketMaxSize) {
+		return 0;
+	}
+	return end - begin;
+}
+
+VQADecoder::FramePacket *VQADecoder::fetchFramePacket(int frame) {
+	FramePacket *packet = &_framePackets[frame % kFramePacketCacheSize];
+	if (packet->frame == frame) {
+		return packet;
+	}
+
+	if (framePacketSize(frame) == 0) {
+		return nullptr;
+	}
+
+	// Read packets of the following frames in one sequential pass,
+	// up to the first frame which is already cached
+	_s->seek(frameOffset(frame));
+	for (int i = frame; i < frame + kFramePacketReadAhead && i < numFrames(); ++i) {
+		FramePacket &slot = _framePackets[i % kFramePacketCacheSize];
+		if (i != frame && slot.frame == i) {
+			break;
+		}
+
+		uint32 size = framePacketSize(i);
+		if (size == 0) {
+			break;
+		}
+
+		if (slot.capacity < size) {
+			delete[] slot.data;
+			slot.data = new uint8[size];
+			slot.capacity = size;
+		}
+
+		if (_s->read(slot.data, size) != size) {
+			slot.frame = -1;
+			break;
+		}
+		slot.frame = i;
+		slot.size  = size;
+	}
+
+	return packet->frame == frame ? packet : nullptr;
 }
 
 bool VQADecoder::readVQHD(Common::SeekableReadStream *s, uint32 size) {
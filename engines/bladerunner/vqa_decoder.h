@@ -135,6 +135,26 @@ public:
 		uint8  *data;
 	};
 
+	// Raw packet of a frame as stored in the stream, kept around so that
+	// video, audio and loop restarts do not have to go back to the archive
+	struct FramePacket {
+		int     frame;
+		uint32  size;
+		uint32  capacity;
+		uint8  *data;
+
+		FramePacket() :
+			frame(-1),
+			size(0),
+			capacity(0),
+			data(nullptr)
+		{}
+	};
+
+	static const int    kFramePacketCacheSize = 32;
+	static const int    kFramePacketReadAhead = 8;
+	static const uint32 kFramePacketMaxSize   = 0x40000;
+
 	class VQAVideoTrack;
 	class VQAAudioTrack;
 
@@ -149,6 +169,8 @@ public:
 
 	uint32  *_frameInfo;
 
+	FramePacket _framePackets[kFramePacketCacheSize];
+
 	uint32   _maxVIEWChunkSize;
 	uint32   _maxZBUFChunkSize;
 	uint32   _maxAESCChunkSize;
@@ -156,7 +178,11 @@ public:
 	VQAVideoTrack *_videoTrack;
 	VQAAudioTrack *_audioTrack;
 
-	void readPacket(uint readFlags);
+	void readPacket(Common::SeekableReadStream *s, uint readFlags);
+
+	uint32       frameOffset(int frame) const;
+	uint32       framePacketSize(int frame) const;
+	FramePacket *fetchFramePacket(int frame);
 
 	bool readVQHD(Common::SeekableReadStream *s, uint32 size);
 	bool readMSCI(Common::SeekableReadStream *s, uint32 size);
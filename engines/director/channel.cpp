@@ -145,7 +145,10 @@ bool Channel::isDirty(Sprite *nextSprite) {
 		// When puppet is set, the overall dirty flag should be set when sprite is
 		// modified.
 		isDirty |= _sprite->_castId != nextSprite->_castId ||
-			_sprite->_ink != nextSprite->_ink;
+			_sprite->_ink != nextSprite->_ink ||
+			_sprite->_foreColor != nextSprite->_foreColor ||
+			_sprite->_backColor != nextSprite->_backColor ||
+			_sprite->_blend != nextSprite->_blend;
 		if (!_sprite->_moveable)
 			isDirty |= _currentPoint != nextSprite->_startPoint;
 		if (!_sprite->_stretch)
@@ -70,6 +70,9 @@ class Score;
 class Channel;
 class CastMember;
 class Stxt;
+struct DirectorPlotData;
+
+typedef void (*InkBlitRowPtr)(void *dst, const void *src, const void *mask, int width, DirectorPlotData *pd);
 
 enum {
 	kDebugLingoExec		= 1 << 0,
@@ -230,13 +233,14 @@ public:
 	void draw();
 
 	Graphics::MacDrawPixPtr getInkDrawPixel();
+	InkBlitRowPtr getInkBlitRow(DirectorPlotData *pd);
 
 	void loadKeyCodes();
 
 	Archive *createArchive();
 
 	// events.cpp
-	void processEvents();
+	void processEvents(bool pollOnly = false);
 	uint32 getMacTicks();
 
 public:
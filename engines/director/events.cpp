@@ -56,7 +56,7 @@ bool processQuitEvent(bool click) {
 
 uint32 DirectorEngine::getMacTicks() { return g_system->getMillis() * 60 / 1000.; }
 
-void DirectorEngine::processEvents() {
+void DirectorEngine::processEvents(bool pollOnly) {
 	debugC(3, kDebugEvents, "\n@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@");
 	debugC(3, kDebugEvents, "@@@@   Processing events");
 	debugC(3, kDebugEvents, "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@\n");
@@ -81,6 +81,10 @@ void DirectorEngine::processEvents() {
 			}
 		}
 
+		// When called from running Lingo, only handle the pending events
+		if (pollOnly)
+			break;
+
 		g_system->delayMillis(10);
 	}
 }
@@ -97,8 +101,8 @@ bool Window::processEvent(Common::Event &event) {
 
 bool Movie::processEvent(Common::Event &event) {
 	Score *sc = getScore();
-	if (sc->getCurrentFrame() >= sc->_frames.size()) {
-		warning("processEvents: request to access frame %d of %d", sc->getCurrentFrame(), sc->_frames.size() - 1);
+	if (sc->getCurrentFrame() >= sc->getFrameCount()) {
+		warning("processEvents: request to access frame %d of %d", sc->getCurrentFrame(), sc->getFrameCount() - 1);
 		return false;
 	}
 	uint16 spriteId = 0;
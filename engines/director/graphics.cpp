@@ -292,6 +292,93 @@ Graphics::MacDrawPixPtr DirectorEngine::getInkDrawPixel() {
 		return &inkDrawPixel<uint32 *>;
 }
 
+// Draws a row of an unscaled surface with a fixed ink. These only cover
+// the inks which don't need the colours decomposed, and match what
+// inkDrawPixel does for them without colourization.
+template <typename T, InkType ink>
+void inkBlitRow(void *dstPtr, const void *srcPtr, const void *maskPtr, int width, DirectorPlotData *p) {
+	T *dst = (T *)dstPtr;
+	const T *src = (const T *)srcPtr;
+	const T *msk = (const T *)maskPtr;
+
+	for (int i = 0; i < width; i++) {
+		if (msk && (ink == kInkTypeMask ? !msk[i] : msk[i]))
+			continue;
+
+		uint32 s = src[i];
+
+		switch (ink) {
+		case kInkTypeBackgndTrans:
+			if (s != p->backColor)
+				dst[i] = s;
+			break;
+		case kInkTypeCopy:
+		case kInkTypeMask:
+			dst[i] = s;
+			break;
+		case kInkTypeTransparent:
+			dst[i] &= s;
+			break;
+		case kInkTypeNotTrans:
+			dst[i] &= ~s;
+			break;
+		case kInkTypeReverse:
+			dst[i] ^= ~s;
+			break;
+		case kInkTypeNotReverse:
+			dst[i] ^= s;
+			break;
+		case kInkTypeGhost:
+			dst[i] |= ~s;
+			break;
+		case kInkTypeNotGhost:
+			dst[i] |= s;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+template <typename T>
+InkBlitRowPtr getInkBlitRowFor(InkType ink) {
+	switch (ink) {
+	case kInkTypeCopy:
+	case kInkTypeMatte:
+	case kInkTypeNotCopy:
+		return &inkBlitRow<T, kInkTypeCopy>;
+	case kInkTypeMask:
+		return &inkBlitRow<T, kInkTypeMask>;
+	case kInkTypeBackgndTrans:
+		return &inkBlitRow<T, kInkTypeBackgndTrans>;
+	case kInkTypeTransparent:
+		return &inkBlitRow<T, kInkTypeTransparent>;
+	case kInkTypeNotTrans:
+		return &inkBlitRow<T, kInkTypeNotTrans>;
+	case kInkTypeReverse:
+		return &inkBlitRow<T, kInkTypeReverse>;
+	case kInkTypeNotReverse:
+		return &inkBlitRow<T, kInkTypeNotReverse>;
+	case kInkTypeGhost:
+		return &inkBlitRow<T, kInkTypeGhost>;
+	case kInkTypeNotGhost:
+		return &inkBlitRow<T, kInkTypeNotGhost>;
+	default:
+		return nullptr;
+	}
+}
+
+InkBlitRowPtr DirectorEngine::getInkBlitRow(DirectorPlotData *pd) {
+	// Colourization, blending, shapes and text need inkDrawPixel
+	if (pd->applyColor || pd->alpha || pd->ms || pd->sprite == kTextSprite)
+		return nullptr;
+
+	if (_pixelformat.bytesPerPixel == 1)
+		return getInkBlitRowFor<byte>(pd->ink);
+	else
+		return getInkBlitRowFor<uint32>(pd->ink);
+}
+
 void DirectorPlotData::setApplyColor() {
 	applyColor = false;
 
@@ -1313,7 +1313,7 @@ void LB::b_preLoad(int nargs) {
 	// We always pretend we preloaded all frames
 	// Returning the number of the last frame successfully "loaded"
 	if (nargs == 0) {
-		g_lingo->_theResult = Datum((int)g_director->getCurrentMovie()->getScore()->_frames.size());
+		g_lingo->_theResult = Datum((int)g_director->getCurrentMovie()->getScore()->getFrameCount());
 		return;
 	}
 
@@ -1765,7 +1765,7 @@ void LB::b_move(int nargs) {
 }
 
 void LB::b_moveableSprite(int nargs) {
-	Frame *frame = g_director->getCurrentMovie()->getScore()->_frames[g_director->getCurrentMovie()->getScore()->getCurrentFrame()];
+	Frame *frame = g_director->getCurrentMovie()->getScore()->getFrame(g_director->getCurrentMovie()->getScore()->getCurrentFrame());
 
 	if (g_lingo->_currentChannelId == -1) {
 		warning("b_moveableSprite: channel Id is missing");
@@ -1879,8 +1879,9 @@ void LB::b_puppetSprite(int nargs) {
 				// sprite in new frame before setting puppet (Majestic).
 				Channel *channel = sc->getChannelById(sprite.asInt());
 
-				channel->replaceSprite(sc->_frames[sc->getNextFrame()]->_sprites[sprite.asInt()]);
+				channel->replaceSprite(sc->getFrame(sc->getNextFrame())->_sprites[sprite.asInt()]);
 				channel->_dirty = true;
+				sc->pinChannelFrames();
 			}
 
 			sc->getSpriteById(sprite.asInt())->_puppet = (bool)state.asInt();
@@ -2034,15 +2035,15 @@ void LB::b_zoomBox(int nargs) {
 	// Looks for endSprite in the next frame
 	Common::Rect endRect = score->_channels[endSpriteId]->getBbox();
 	if (endRect.isEmpty()) {
-		if ((uint)curFrame + 1 < score->_frames.size()) {
-			Channel endChannel(score->_frames[curFrame + 1]->_sprites[endSpriteId]);
+		if ((uint)curFrame + 1 < score->getFrameCount()) {
+			Channel endChannel(score->getFrame(curFrame + 1)->_sprites[endSpriteId]);
 			endRect = endChannel.getBbox();
 		}
 	}
 
 	if (endRect.isEmpty()) {
 		if ((uint)curFrame - 1 > 0) {
-			Channel endChannel(score->_frames[curFrame - 1]->_sprites[endSpriteId]);
+			Channel endChannel(score->getFrame(curFrame - 1)->_sprites[endSpriteId]);
 			endRect = endChannel.getBbox();
 		}
 	}
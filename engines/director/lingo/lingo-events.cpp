@@ -123,7 +123,7 @@ void Movie::queueSpriteEvent(LEvent event, int eventId, int spriteId) {
 	 * When more than one movie script [...]
 	 * [D4 docs] */
 
-	Frame *currentFrame = _score->_frames[_score->getCurrentFrame()];
+	Frame *currentFrame = _score->getFrame(_score->getCurrentFrame());
 	assert(currentFrame != nullptr);
 	Sprite *sprite = _score->getSpriteById(spriteId);
 
@@ -161,8 +161,8 @@ void Movie::queueFrameEvent(LEvent event, int eventId) {
 	// 	entity = score->getCurrentFrame();
 	// } else {
 
-	assert(_score->_frames[_score->getCurrentFrame()] != nullptr);
-	int scriptId = _score->_frames[_score->getCurrentFrame()]->_actionId;
+	assert(_score->getFrame(_score->getCurrentFrame()) != nullptr);
+	int scriptId = _score->getFrame(_score->getCurrentFrame())->_actionId;
 	if (!scriptId)
 		return;
 
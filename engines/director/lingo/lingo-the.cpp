@@ -510,7 +510,7 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 		break;
 	case kTheLastFrame:
 		d.type = INT;
-		d.u.i = score->_frames.size() - 1;
+		d.u.i = score->getFrameCount() - 1;
 		break;
 	case kTheLastKey:
 		d.type = INT;
@@ -22,6 +22,7 @@
 
 #include "common/file.h"
 #include "common/config-manager.h"
+#include "common/system.h"
 
 #include "graphics/macgui/macwindowmanager.h"
 
@@ -151,6 +152,7 @@ Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
 
 	_currentChannelId = -1;
 	_globalCounter = 0;
+	_lastYieldTime = 0;
 	_pc = 0;
 	_abort = false;
 	_indef = kStateNone;
@@ -576,6 +578,56 @@ Common::String Lingo::decodeInstruction(LingoArchive *archive, ScriptData *sd, u
 }
 
 void Lingo::execute(uint pc) {
+	// Disassembling and tracing every instruction is expensive, so only
+	// do it when it is going to be printed
+	if (debugChannelSet(1, kDebugLingoExec) || debugChannelSet(-1, kDebugFewFramesOnly)) {
+		executeTraced(pc);
+		return;
+	}
+
+	uint localCounter = 0;
+
+	for (_pc = pc; !_abort;) {
+		inst i = (*_currentScript)[_pc];
+		if (i == STOP)
+			break;
+
+		_pc++;
+		(*i)();
+
+		if (!_abort && _pc >= (*_currentScript).size()) {
+			warning("Lingo::execute(): Bad PC (%d)", _pc);
+			break;
+		}
+
+		_globalCounter++;
+		localCounter++;
+
+		// process events every so often
+		if (localCounter % 100 == 0) {
+			pollEvents();
+			if (_vm->getCurrentMovie()->getScore()->_playState == kPlayStopped)
+				break;
+		}
+	}
+
+	_abort = false;
+}
+
+void Lingo::pollEvents() {
+	// Only handle the pending events, but every kLingoYieldTime ms let the
+	// engine wait for events as well. Scripts which loop until the mouse is
+	// clicked or a timer runs out then don't take up all of the CPU.
+	const uint32 now = g_system->getMillis();
+	const bool yield = now - _lastYieldTime >= kLingoYieldTime;
+
+	_vm->processEvents(!yield);
+
+	if (yield)
+		_lastYieldTime = g_system->getMillis();
+}
+
+void Lingo::executeTraced(uint pc) {
 	uint localCounter = 0;
 
 	for (_pc = pc; !_abort && (*_currentScript)[_pc] != STOP;) {
@@ -621,7 +673,7 @@ void Lingo::execute(uint pc) {
 
 		// process events every so often
 		if (localCounter % 100 == 0) {
-			_vm->processEvents();
+			pollEvents();
 			if (_vm->getCurrentMovie()->getScore()->_playState == kPlayStopped)
 				break;
 		}
@@ -1273,13 +1325,16 @@ void Lingo::varAssign(Datum &var, Datum &value, bool global, DatumHash *localvar
 	}
 
 	if (var.type == VAR) {
-		Common::String name = *var.u.s;
-
-		if (localvars && localvars->contains(name)) {
-			(*localvars)[name] = value;
-			if (global)
-				warning("varAssign: variable %s is local, not global", name.c_str());
-			return;
+		const Common::String &name = *var.u.s;
+
+		if (localvars) {
+			DatumHash::iterator it = localvars->find(name);
+			if (it != localvars->end()) {
+				it->_value = value;
+				if (global)
+					warning("varAssign: variable %s is local, not global", name.c_str());
+				return;
+			}
 		}
 		if (_currentMe.type == OBJECT && _currentMe.u.obj->hasProp(name)) {
 			_currentMe.u.obj->setProp(name, value);
@@ -1287,8 +1342,9 @@ void Lingo::varAssign(Datum &var, Datum &value, bool global, DatumHash *localvar
 				warning("varAssign: variable %s is instance or property, not global", name.c_str());
 			return;
 		}
-		if (_globalvars.contains(name)) {
-			_globalvars[name] = value;
+		DatumHash::iterator it = _globalvars.find(name);
+		if (it != _globalvars.end()) {
+			it->_value = value;
 			if (!global)
 				warning("varAssign: variable %s is global, not local", name.c_str());
 			return;
@@ -1328,23 +1384,26 @@ Datum Lingo::varFetch(Datum &var, bool global, DatumHash *localvars, bool silent
 	Datum result;
 
 	if (var.type == VAR) {
-		Datum d;
-		Common::String name = *var.u.s;
-
-		if (localvars && localvars->contains(name)) {
-			if (global)
-				warning("varFetch: variable %s is local, not global", name.c_str());
-			return (*localvars)[name];
+		const Common::String &name = *var.u.s;
+
+		if (localvars) {
+			DatumHash::iterator it = localvars->find(name);
+			if (it != localvars->end()) {
+				if (global)
+					warning("varFetch: variable %s is local, not global", name.c_str());
+				return it->_value;
+			}
 		}
 		if (_currentMe.type == OBJECT && _currentMe.u.obj->hasProp(name)) {
 			if (global)
 				warning("varFetch: variable %s is instance or property, not global", name.c_str());
 			return _currentMe.u.obj->getProp(name);
 		}
-		if (_globalvars.contains(name)) {
+		DatumHash::iterator it = _globalvars.find(name);
+		if (it != _globalvars.end()) {
 			if (!global)
 				warning("varFetch: variable %s is global, not local", name.c_str());
-			return _globalvars[name];
+			return it->_value;
 		}
 
 		if (!silent)
@@ -62,6 +62,10 @@ enum VarType {
 	kVarLocal
 };
 
+enum {
+	kLingoYieldTime = 10	// ms of running Lingo between waits for events
+};
+
 typedef void (*inst)(void);
 #define	STOP (inst)0
 #define ENTITY_INDEX(t,id) ((t) * 100000 + (id))
@@ -292,6 +296,8 @@ public:
 
 public:
 	void execute(uint pc);
+	void executeTraced(uint pc);
+	void pollEvents();
 	void pushContext(const Symbol funcSym, bool allowRetVal, Datum defaultRetVal);
 	void popContext();
 	void cleanLocalVars();
@@ -466,6 +472,7 @@ public:
 	Common::HashMap<int, LingoV4TheEntity *> _lingoV4TheEntity;
 
 	uint _globalCounter;
+	uint32 _lastYieldTime;
 	uint _pc;
 
 	StackData _stack;
@@ -77,11 +77,25 @@ Score::Score(Movie *movie) {
 	_numChannelsDisplayed = 0;
 
 	_framesRan = 0; // used by kDebugFewFramesOnly and kDebugScreenshot
+
+	_framesData = nullptr;
+	_framesDataSize = 0;
+	_framesBigEndian = false;
+	_decodeChannelData = nullptr;
+	_decodeFrameId = 0;
+	_frameUseCounter = 0;
+	_spriteCastsSet = false;
 }
 
 Score::~Score() {
-	for (uint i = 0; i < _frames.size(); i++)
-		delete _frames[i];
+	for (uint i = 0; i < _frameCache.size(); i++)
+		delete _frameCache[i];
+
+	for (uint i = 0; i < _frameCheckpoints.size(); i++)
+		free(_frameCheckpoints[i]);
+
+	free(_framesData);
+	free(_decodeChannelData);
 
 	for (uint i = 0; i < _channels.size(); i++)
 		delete _channels[i];
@@ -94,7 +108,7 @@ Score::~Score() {
 }
 
 int Score::getCurrentPalette() {
-	return _frames[_currentFrame]->_palette.paletteId;
+	return getFrame(_currentFrame)->_palette.paletteId;
 }
 
 int Score::resolvePaletteId(int id) {
@@ -255,15 +269,18 @@ void Score::startPlay() {
 	_lastPalette = _movie->getCast()->_defaultPalette;
 	_vm->setPalette(resolvePaletteId(_lastPalette));
 
-	if (_frames.size() <= 1) {	// We added one empty sprite
+	if (getFrameCount() <= 1) {	// We added one empty sprite
 		warning("Score::startLoop(): Movie has no frames");
 		_playState = kPlayStopped;
 	}
 
 	// All frames in the same movie have the same number of channels
-	if (_playState != kPlayStopped)
-		for (uint i = 0; i < _frames[1]->_sprites.size(); i++)
-			_channels.push_back(new Channel(_frames[1]->_sprites[i], i));
+	if (_playState != kPlayStopped) {
+		Frame *frame = getFrame(1);
+		for (uint i = 0; i < frame->_sprites.size(); i++)
+			_channels.push_back(new Channel(frame->_sprites[i], i));
+		pinChannelFrames();
+	}
 
 	if (_vm->getVersion() >= 300)
 		_movie->processEvent(kEventStartMovie);
@@ -341,7 +358,7 @@ void Score::update() {
 
 		// If there is a transition, the perFrameHook is called
 		// after each transition subframe instead.
-		if (_frames[_currentFrame]->_transType == 0) {
+		if (getFrame(_currentFrame)->_transType == 0) {
 			_lingo->executePerFrameHook(_currentFrame, 0);
 		}
 	}
@@ -357,7 +374,7 @@ void Score::update() {
 
 	_vm->_skipFrameAdvance = false;
 
-	if (_currentFrame >= _frames.size()) {
+	if (_currentFrame >= getFrameCount()) {
 		if (debugChannelSet(-1, kDebugNoLoop)) {
 			_playState = kPlayStopped;
 			return;
@@ -377,7 +394,7 @@ void Score::update() {
 
 	debugC(1, kDebugImages, "******************************  Current frame: %d", _currentFrame);
 
-	_lingo->executeImmediateScripts(_frames[_currentFrame]);
+	_lingo->executeImmediateScripts(getFrame(_currentFrame));
 
 	if (_vm->getVersion() >= 600) {
 		// _movie->processEvent(kEventBeginSprite);
@@ -402,7 +419,7 @@ void Score::update() {
 	}
 	// TODO Director 6 - another order
 
-	byte tempo = _frames[_currentFrame]->_tempo;
+	byte tempo = getFrame(_currentFrame)->_tempo;
 	if (tempo) {
 		_puppetTempo = 0;
 	} else if (_puppetTempo) {
@@ -446,7 +463,7 @@ void Score::renderFrame(uint16 frameId, RenderMode mode) {
 	if (!renderTransition(frameId))
 		renderSprites(frameId, mode);
 
-	int currentPalette = _frames[frameId]->_palette.paletteId;
+	int currentPalette = getFrame(frameId)->_palette.paletteId;
 	if (!_puppetPalette && currentPalette != 0 && currentPalette != _lastPalette) {
 		_lastPalette = currentPalette;
 		g_director->setPalette(resolvePaletteId(currentPalette));
@@ -455,7 +472,7 @@ void Score::renderFrame(uint16 frameId, RenderMode mode) {
 	if (mode != kRenderNoWindowRender)
 		_window->render();
 
-	if (_frames[frameId]->_sound1 || _frames[frameId]->_sound2)
+	if (getFrame(frameId)->_sound1 || getFrame(frameId)->_sound2)
 		playSoundChannel(frameId);
 
 	if (_cursorDirty) {
@@ -465,7 +482,7 @@ void Score::renderFrame(uint16 frameId, RenderMode mode) {
 }
 
 bool Score::renderTransition(uint16 frameId) {
-	Frame *currentFrame = _frames[frameId];
+	Frame *currentFrame = getFrame(frameId);
 	TransParams *tp = _window->_puppetTransition;
 
 	if (tp) {
@@ -488,10 +505,12 @@ void Score::renderSprites(uint16 frameId, RenderMode mode) {
 
 	_movie->_videoPlayback = false;
 
+	Frame *frame = getFrame(frameId);
+
 	for (uint16 i = 0; i < _channels.size(); i++) {
 		Channel *channel = _channels[i];
 		Sprite *currentSprite = channel->_sprite;
-		Sprite *nextSprite = _frames[frameId]->_sprites[i];
+		Sprite *nextSprite = frame->_sprites[i];
 
 		// widget content has changed and needs a redraw.
 		// this doesn't include changes in dimension or position!
@@ -514,6 +533,9 @@ void Score::renderSprites(uint16 frameId, RenderMode mode) {
 			channel->setClean(nextSprite, i, true);
 		}
 	}
+
+	// The channels took over the sprites of the frame, puppets keep theirs
+	pinChannelFrames();
 }
 
 void Score::renderCursor(Common::Point pos) {
@@ -628,7 +650,7 @@ Channel *Score::getChannelById(uint16 id) {
 }
 
 void Score::playSoundChannel(uint16 frameId) {
-	Frame *frame = _frames[frameId];
+	Frame *frame = getFrame(frameId);
 
 	debugC(5, kDebugLoading, "playSoundChannel(): Sound1 %d Sound2 %d", frame->_sound1, frame->_sound2);
 	DirectorSound *sound = _vm->getSoundManager();
@@ -704,69 +726,235 @@ void Score::loadFrames(Common::SeekableReadStreamEndian &stream) {
 		warning("STUB: Score::loadFrames. unk1: %x unk2: %x unk3: %x unk4: %x unk5: %x unk6: %x", unk1, unk2, unk3, unk4, unk5, unk6);
 	}
 
-	uint16 channelSize;
-	uint16 channelOffset;
+	// Keep the frame stream around, frames are decoded from it when needed
+	uint32 dataSize = MIN<uint32>(size, stream.size() - stream.pos());
+	_framesData = (byte *)malloc(dataSize);
+	_framesDataSize = stream.read(_framesData, dataSize);
+	_framesBigEndian = stream.isBE();
 
-	Frame *initial = new Frame(this, _numChannelsDisplayed);
 	// Push a frame at frame#0 position.
 	// This makes all indexing simpler
-	_frames.push_back(initial);
+	_frameOffsets.push_back(0);
+	_frameCheckpoints.push_back((byte *)calloc(kChannelDataSize, 1));
 
 	// This is a representation of the channelData. It gets overridden
 	// partically by channels, hence we keep it and read the score from left to right
 	//
 	// TODO Merge it with shared cast
-	byte channelData[kChannelDataSize];
-	memset(channelData, 0, kChannelDataSize);
-
-	while (size != 0 && !stream.eos()) {
-		uint16 frameSize = stream.readUint16();
-		debugC(3, kDebugLoading, "++++++++++ score frame %d (frameSize %d) size %d", _frames.size(), frameSize, size);
+	_decodeChannelData = (byte *)calloc(kChannelDataSize, 1);
+	_decodeFrameId = 0;
+
+	// Find where each frame starts, and keep a copy of the channel data
+	// every kFrameCheckpointInterval frames. The scripts the frames use are
+	// noted for loadActions(), reading each frame's channels into the same
+	// scratch frame.
+	Common::MemoryReadStreamEndian frameStream(_framesData, _framesDataSize, _framesBigEndian);
+	Frame scratch(this, _numChannelsDisplayed);
+	_frameScriptRefs[0] = true;
+
+	while (size != 0 && !frameStream.eos()) {
+		uint32 offset = frameStream.pos();
+		uint16 frameSize = frameStream.readUint16();
+		debugC(3, kDebugLoading, "++++++++++ score frame %d (frameSize %d) size %d", _frameOffsets.size(), frameSize, size);
 
 		if (frameSize > 0) {
-			Frame *frame = new Frame(this, _numChannelsDisplayed);
 			size -= frameSize;
-			frameSize -= 2;
-
-			while (frameSize != 0) {
-
-				if (_vm->getVersion() < 400) {
-					channelSize = stream.readByte() * 2;
-					channelOffset = stream.readByte() * 2;
-					frameSize -= channelSize + 2;
-				} else {
-					channelSize = stream.readUint16();
-					channelOffset = stream.readUint16();
-					frameSize -= channelSize + 4;
-				}
 
-				assert(channelOffset + channelSize < kChannelDataSize);
-				stream.read(&channelData[channelOffset], channelSize);
-			}
+			uint16 frameId = _frameOffsets.size();
+			_frameOffsets.push_back(offset);
 
-			Common::MemoryReadStreamEndian *str = new Common::MemoryReadStreamEndian(channelData, ARRAYSIZE(channelData), stream.isBE());
-			// str->hexdump(str->size(), 32);
-			frame->readChannels(str);
-			delete str;
+			readFrameDelta(frameId, _decodeChannelData);
+			_decodeFrameId = frameId;
 
-			debugC(8, kDebugLoading, "Score::loadFrames(): Frame %d actionId: %d", _frames.size(), frame->_actionId);
+			Common::MemoryReadStreamEndian str(_decodeChannelData, kChannelDataSize, _framesBigEndian);
+			scratch.readChannels(&str);
 
-			_frames.push_back(frame);
+			_frameScriptRefs[scratch._actionId] = true;
+			for (uint16 j = 0; j <= scratch._numChannels; j++)
+				_frameScriptRefs[scratch._sprites[j]->_scriptId] = true;
+
+			if (frameId % kFrameCheckpointInterval == 0) {
+				byte *checkpoint = (byte *)malloc(kChannelDataSize);
+				memcpy(checkpoint, _decodeChannelData, kChannelDataSize);
+				_frameCheckpoints.push_back(checkpoint);
+			}
+
+			frameStream.seek(offset + frameSize);
 		} else {
 			warning("zero sized frame!? exiting loop until we know what to do with the tags that follow.");
 			size = 0;
 		}
 	}
+
+	_frameCache.resize(_frameOffsets.size());
+	_frameLastUsed.resize(_frameOffsets.size());
 }
 
-void Score::setSpriteCasts() {
-	// Update sprite cache of cast pointers/info
-	for (uint16 i = 0; i < _frames.size(); i++) {
-		for (uint16 j = 0; j < _frames[i]->_sprites.size(); j++) {
-			_frames[i]->_sprites[j]->setCast(_frames[i]->_sprites[j]->_castId);
+void Score::readFrameDelta(uint16 frameId, byte *channelData) {
+	Common::MemoryReadStreamEndian stream(_framesData, _framesDataSize, _framesBigEndian);
+	stream.seek(_frameOffsets[frameId]);
 
-			debugC(1, kDebugImages, "Score::setSpriteCasts(): Frame: %d Channel: %d castId: %d type: %d", i, j, _frames[i]->_sprites[j]->_castId, _frames[i]->_sprites[j]->_spriteType);
+	uint16 frameSize = stream.readUint16() - 2;
+	uint16 channelSize;
+	uint16 channelOffset;
+
+	while (frameSize != 0 && !stream.eos()) {
+		if (_vm->getVersion() < 400) {
+			channelSize = stream.readByte() * 2;
+			channelOffset = stream.readByte() * 2;
+			frameSize -= channelSize + 2;
+		} else {
+			channelSize = stream.readUint16();
+			channelOffset = stream.readUint16();
+			frameSize -= channelSize + 4;
 		}
+
+		assert(channelOffset + channelSize < kChannelDataSize);
+		stream.read(&channelData[channelOffset], channelSize);
+	}
+}
+
+Frame *Score::decodeFrame(uint16 frameId) {
+	Frame *frame = new Frame(this, _numChannelsDisplayed);
+
+	if (frameId > 0) {
+		// Continue from the last decoded frame when moving forward, otherwise
+		// start from the closest checkpoint
+		uint16 checkpoint = frameId / kFrameCheckpointInterval;
+		if (_decodeFrameId > frameId || _decodeFrameId < checkpoint * kFrameCheckpointInterval) {
+			memcpy(_decodeChannelData, _frameCheckpoints[checkpoint], kChannelDataSize);
+			_decodeFrameId = checkpoint * kFrameCheckpointInterval;
+		}
+
+		while (_decodeFrameId < frameId)
+			readFrameDelta(++_decodeFrameId, _decodeChannelData);
+
+		Common::MemoryReadStreamEndian str(_decodeChannelData, kChannelDataSize, _framesBigEndian);
+		frame->readChannels(&str);
+
+		debugC(8, kDebugLoading, "Score::decodeFrame(): Frame %d actionId: %d", frameId, frame->_actionId);
+	}
+
+	setFrameSpriteCasts(frame, frameId);
+
+	return frame;
+}
+
+Frame *Score::getFrame(uint16 frameId) {
+	assert(frameId < _frameCache.size());
+
+	Frame *frame = _frameCache[frameId];
+	if (!frame) {
+		// Frames unpinned since may have taken the list past its limit
+		while (_cachedFrameIds.size() >= kMaxCachedFrames) {
+			if (!evictFrame())
+				break;
+		}
+
+		frame = decodeFrame(frameId);
+		_frameCache[frameId] = frame;
+		_cachedFrameIds.push_back(frameId);
+
+		// Only the frames shown by channels are pinned, so no matter how long
+		// the movie plays, only so many frames are decoded at once
+		assert(_cachedFrameIds.size() <= kMaxCachedFrames && _pinnedFrameIds.size() <= _channels.size());
+	}
+
+	_frameLastUsed[frameId] = ++_frameUseCounter;
+	return frame;
+}
+
+void Score::pinChannelFrames() {
+	Common::Array<uint16> pinned;
+	Frame *lastFrame = nullptr;
+
+	for (uint i = 0; i < _channels.size(); i++) {
+		Frame *frame = _channels[i]->_sprite->getFrame();
+
+		// Neighbouring channels mostly show the same frame
+		if (frame == lastFrame)
+			continue;
+		lastFrame = frame;
+
+		bool found = false;
+		for (uint j = 0; j < pinned.size() && !found; j++)
+			found = _frameCache[pinned[j]] == frame;
+
+		for (uint j = 0; j < _pinnedFrameIds.size() && !found; j++) {
+			if (_frameCache[_pinnedFrameIds[j]] == frame) {
+				pinned.push_back(_pinnedFrameIds[j]);
+				found = true;
+			}
+		}
+
+		for (uint j = 0; j < _cachedFrameIds.size() && !found; j++) {
+			if (_frameCache[_cachedFrameIds[j]] == frame) {
+				pinned.push_back(_cachedFrameIds[j]);
+				_cachedFrameIds[j] = _cachedFrameIds.back();
+				_cachedFrameIds.pop_back();
+				found = true;
+			}
+		}
+	}
+
+	// Frames no channel shows any more can be dropped again. Changes made to
+	// their sprites are lost then, the score has them drawn afresh anyway
+	for (uint i = 0; i < _pinnedFrameIds.size(); i++) {
+		bool stillPinned = false;
+		for (uint j = 0; j < pinned.size() && !stillPinned; j++)
+			stillPinned = pinned[j] == _pinnedFrameIds[i];
+
+		if (!stillPinned)
+			_cachedFrameIds.push_back(_pinnedFrameIds[i]);
+	}
+
+	_pinnedFrameIds = pinned;
+}
+
+bool Score::evictFrame() {
+	// Drop the least recently used frame which isn't pinned, but not the
+	// current one
+	int victim = -1;
+
+	for (uint i = 0; i < _cachedFrameIds.size(); i++) {
+		uint16 frameId = _cachedFrameIds[i];
+		if (frameId == _currentFrame)
+			continue;
+		if (victim == -1 || _frameLastUsed[frameId] < _frameLastUsed[_cachedFrameIds[victim]])
+			victim = i;
+	}
+
+	if (victim == -1)
+		return false;
+
+	uint16 frameId = _cachedFrameIds[victim];
+	delete _frameCache[frameId];
+	_frameCache[frameId] = nullptr;
+
+	_cachedFrameIds[victim] = _cachedFrameIds.back();
+	_cachedFrameIds.pop_back();
+	return true;
+}
+
+void Score::setSpriteCasts() {
+	// Update sprite cache of cast pointers/info. Frames decoded from now on
+	// get them set when they are decoded.
+	_spriteCastsSet = true;
+
+	for (uint i = 0; i < _frameCache.size(); i++) {
+		if (_frameCache[i])
+			setFrameSpriteCasts(_frameCache[i], i);
+	}
+}
+
+void Score::setFrameSpriteCasts(Frame *frame, uint16 frameId) {
+	if (!_spriteCastsSet)
+		return;
+
+	for (uint16 j = 0; j < frame->_sprites.size(); j++) {
+		frame->_sprites[j]->setCast(frame->_sprites[j]->_castId);
+
+		debugC(1, kDebugImages, "Score::setSpriteCasts(): Frame: %d Channel: %d castId: %d type: %d", frameId, j, frame->_sprites[j]->_castId, frame->_sprites[j]->_spriteType);
 	}
 }
 
@@ -855,19 +1043,7 @@ void Score::loadActions(Common::SeekableReadStreamEndian &stream) {
 			break;
 	}
 
-	bool *scriptRefs = (bool *)calloc(_actions.size() + 1, sizeof(bool));
-
-	// Now let's scan which scripts are actually referenced
-	for (uint i = 0; i < _frames.size(); i++) {
-		if (_frames[i]->_actionId <= _actions.size())
-			scriptRefs[_frames[i]->_actionId] = true;
-
-		for (uint16 j = 0; j <= _frames[i]->_numChannels; j++) {
-			if (_frames[i]->_sprites[j]->_scriptId <= _actions.size())
-				scriptRefs[_frames[i]->_sprites[j]->_scriptId] = true;
-		}
-	}
-
+	// The scripts which are actually referenced were noted by loadFrames()
 	Common::HashMap<uint16, Common::String>::iterator j;
 
 	if (ConfMan.getBool("dump_scripts"))
@@ -877,7 +1053,7 @@ void Score::loadActions(Common::SeekableReadStreamEndian &stream) {
 		}
 
 	for (j = _actions.begin(); j != _actions.end(); ++j) {
-		if (!scriptRefs[j->_key]) {
+		if (!_frameScriptRefs.contains(j->_key)) {
 			// Check if it is empty
 			bool empty = true;
 			for (const char *ptr = j->_value.c_str(); *ptr; ptr++)
@@ -897,8 +1073,6 @@ void Score::loadActions(Common::SeekableReadStreamEndian &stream) {
 			processImmediateFrameScript(j->_value, j->_key);
 		}
 	}
-
-	free(scriptRefs);
 }
 
 } // End of namespace Director
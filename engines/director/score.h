@@ -53,6 +53,11 @@ class Channel;
 class Sprite;
 class CastMember;
 
+enum {
+	kFrameCheckpointInterval = 32,	// Frames between full channel data checkpoints
+	kMaxCachedFrames = 64			// Decoded frames kept in memory
+};
+
 enum RenderMode {
 	kRenderModeNormal,
 	kRenderForceUpdate,
@@ -84,6 +89,12 @@ public:
 	void step();
 	void stopPlay();
 
+	Frame *getFrame(uint16 frameId);
+	// Keeps the frames whose sprites the channels point to decoded, and lets
+	// the others be dropped again. Called whenever channels take new sprites.
+	void pinChannelFrames();
+	uint16 getFrameCount() const { return _frameOffsets.size(); }
+
 	void setCurrentFrame(uint16 frameId) { _nextFrame = frameId; }
 	uint16 getCurrentFrame() { return _currentFrame; }
 	int getNextFrame() { return _nextFrame; }
@@ -120,9 +131,13 @@ private:
 
 	bool processImmediateFrameScript(Common::String s, int id);
 
+	Frame *decodeFrame(uint16 frameId);
+	void readFrameDelta(uint16 frameId, byte *channelData);
+	void setFrameSpriteCasts(Frame *frame, uint16 frameId);
+	bool evictFrame();
+
 public:
 	Common::Array<Channel *> _channels;
-	Common::Array<Frame *> _frames;
 	Common::SortedArray<Label *> *_labels;
 	Common::HashMap<uint16, Common::String> _actions;
 	Common::HashMap<uint16, bool> _immediateActions;
@@ -156,6 +171,28 @@ private:
 	uint16 _nextFrame;
 	int _currentLabel;
 	DirectorSound *_soundManager;
+
+	// The VWSC frame stream. Frames are decoded from it on demand, starting
+	// from the closest checkpoint of the full channel data
+	byte *_framesData;
+	uint32 _framesDataSize;
+	bool _framesBigEndian;
+	Common::Array<uint32> _frameOffsets;
+	Common::Array<byte *> _frameCheckpoints;
+	byte *_decodeChannelData;
+	int _decodeFrameId;
+
+	// Decoded frames. Those shown by channels are pinned, of the others,
+	// listed in _cachedFrameIds, the least recently used are dropped
+	Common::Array<Frame *> _frameCache;
+	Common::Array<uint32> _frameLastUsed;
+	Common::Array<uint16> _pinnedFrameIds;
+	Common::Array<uint16> _cachedFrameIds;
+	uint32 _frameUseCounter;
+	bool _spriteCastsSet;
+
+	// Scripts referenced by any frame, found while indexing the frames
+	Common::HashMap<uint16, bool> _frameScriptRefs;
 };
 
 } // End of namespace Director
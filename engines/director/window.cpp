@@ -60,6 +60,9 @@ Window::Window(int id, bool scrollable, bool resizable, bool editable, Graphics:
 	_windowType = -1;
 	_titleVisible = true;
 	updateBorderType();
+
+	_dirtyPixels = 0;
+	_spritePixels = 0;
 }
 
 Window::~Window() {
@@ -114,9 +117,13 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 	if (!blitTo)
 		blitTo = _composeSurface;
 
+	_dirtyPixels = 0;
+	_spritePixels = 0;
+
 	for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); i++) {
 		const Common::Rect &r = *i;
 		blitTo->fillRect(r, _stageColor);
+		_dirtyPixels += r.width() * r.height();
 
 		_dirtyChannels = _currentMovie->getScore()->getSpriteIntersections(r);
 		for (int pass = 0; pass < 2; pass++) {
@@ -135,6 +142,9 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 		}
 	}
 
+	debugC(2, kDebugImages, "Window::render(): %d dirty rects, %d pixels redrawn, %d sprite pixels drawn",
+		_dirtyRects.size(), _dirtyPixels, _spritePixels);
+
 	_dirtyRects.clear();
 	_contentIsDirty = true;
 
@@ -159,6 +169,9 @@ void Window::inkBlitFrom(Channel *channel, Common::Rect destRect, Graphics::Mana
 	Common::Rect srcRect = channel->getBbox();
 	destRect.clip(srcRect);
 
+	if (!destRect.isEmpty())
+		_spritePixels += destRect.width() * destRect.height();
+
 	DirectorPlotData pd = channel->getPlotData();
 	pd.destRect = destRect;
 	pd.dst = blitTo;
@@ -249,9 +262,17 @@ void Window::inkBlitSurface(DirectorPlotData *pd, Common::Rect &srcRect, const G
 	if (pd->sprite == kTextSprite)
 		pd->applyColor = false;
 
+	InkBlitRowPtr blitRow = g_director->getInkBlitRow(pd);
+
 	pd->srcPoint.y = abs(srcRect.top - pd->destRect.top);
 	for (int i = 0; i < pd->destRect.height(); i++, pd->srcPoint.y++) {
-		if (_wm->_pixelformat.bytesPerPixel == 1) {
+		if (blitRow) {
+			pd->srcPoint.x = abs(srcRect.left - pd->destRect.left);
+			blitRow(pd->dst->getBasePtr(pd->destRect.left, pd->destRect.top + i),
+					pd->srf->getBasePtr(pd->srcPoint.x, pd->srcPoint.y),
+					mask ? mask->getBasePtr(pd->srcPoint.x, pd->srcPoint.y) : nullptr,
+					pd->destRect.width(), pd);
+		} else if (_wm->_pixelformat.bytesPerPixel == 1) {
 			pd->srcPoint.x = abs(srcRect.left - pd->destRect.left);
 			const byte *msk = mask ? (const byte *)mask->getBasePtr(pd->srcPoint.x, pd->srcPoint.y) : nullptr;
 
@@ -184,6 +184,10 @@ private:
 	int _windowType;
 	bool _titleVisible;
 
+	// Per frame counters of the pixels composited by render()
+	uint32 _dirtyPixels;
+	uint32 _spritePixels;
+
 private:
 	int preprocessColor(DirectorPlotData *p, uint32 src);
 
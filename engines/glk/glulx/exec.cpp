@@ -38,6 +38,7 @@ void Glulx::execute_loop() {
 #ifdef FLOAT_SUPPORT
 	gfloat32 valf, valf1, valf2;
 #endif /* FLOAT_SUPPORT */
+	uint32 startTime = g_system->getMillis();
 
 	while (!done_executing && !g_vm->shouldQuit()) {
 
@@ -48,6 +49,21 @@ void Glulx::execute_loop() {
 
 		/* Stash the current opcode's address, in case the interpreter needs to serialize the VM state out-of-band. */
 		prevpc = pc;
+		exec_opcount++;
+
+		/* Instructions in ROM can't change, so their decoded form is kept in
+		   predecode_cache and reused the next time they're executed. */
+		if (pc < ramstart) {
+			predecode_t *pd = &predecode_cache[(pc ^ (pc >> 14)) & (PREDECODE_CACHE_SIZE - 1)];
+			bool cached = (pd->pc == pc);
+			if (cached || predecode_instruction(pd, pc)) {
+				if (cached)
+					exec_predecoded++;
+				opcode = pd->opcode;
+				parse_predecoded_operands(inst, pd);
+				goto PerformOpcode;
+			}
+		}
 
 		/* Fetch the opcode number. */
 		opcode = Mem1(pc);
@@ -88,6 +104,7 @@ void Glulx::execute_loop() {
 		   into inst. This moves the PC up to the end of the instruction. */
 		parse_operands(inst, oplist);
 
+PerformOpcode:
 		/* Perform the opcode. This switch statement is split in two, based
 		   on some paranoid suspicions about the ability of compilers to
 		   optimize large-range switches. Ignore that. */
@@ -1050,6 +1067,9 @@ PerformJump: /* goto label for successful jumping... ironic, no? */
 		}
 	}
 	/* done executing */
+	uint32 elapsed = MAX<uint32>(g_system->getMillis() - startTime, 1);
+	debugC(1, kDebugCore, "Glulx: executed %u instructions (%u predecoded) in %u ms, %u instructions/sec",
+		exec_opcount, exec_predecoded, elapsed, (uint32)((uint64)exec_opcount * 1000 / elapsed));
 #if VM_DEBUGGER
 	debugger_handle_quit();
 #endif /* VM_DEBUGGER */
@@ -146,6 +146,16 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Direct-mapped cache of decoded instructions in ROM, indexed by a hash of their address.
+	 */
+	predecode_t *predecode_cache;
+
+	/**
+	 * Executed instruction counts, reported on the core debug channel when the game ends.
+	 */
+	uint32 exec_opcount, exec_predecoded;
+
 	/**@}*/
 
 	/**
@@ -158,9 +168,24 @@ private:
 	 */
 	int max_undo_level;
 
+	/**
+	 * Memory budget in bytes for the undo chain. The oldest undo levels are dropped when
+	 * it is exceeded, although the most recent one is always kept. This can be adjusted
+	 * before startup, or with the "undo_memory" setting (in KB).
+	 */
+	uint max_undo_memory;
+
 	int undo_chain_size;
 	int undo_chain_num;
 	byte **undo_chain;
+	uint undo_chain_memory;
+
+	/**
+	 * Copy of RAM (ramstart to endmem) as of the most recent undo level. Each undo level
+	 * only stores the pages that differ from the level before it.
+	 */
+	byte *undo_shadow;
+	uint undo_shadow_len, undo_shadow_alloc;
 
 	/**
 	 * This will contain a copy of RAM (ramstate to endmem) as it exists in the game file.
@@ -352,6 +377,27 @@ protected:
 	 */
 
 	uint write_memstate(dest_t *dest);
+
+	/**
+	 * Updates the undo shadow copy of RAM to the current memory, writing the previous
+	 * contents of every page that changed into dest
+	 */
+	uint write_undo_pagediff(dest_t *dest);
+
+	/**
+	 * Copies the undo shadow copy of RAM back to memory
+	 */
+	uint restore_undo_shadow(uint newendmem);
+
+	/**
+	 * Puts back the pages written by write_undo_pagediff into the undo shadow copy of RAM
+	 */
+	uint read_undo_pagediff(dest_t *dest);
+
+	/**
+	 * Frees the oldest level of the undo chain
+	 */
+	void drop_oldest_undo();
 	uint write_heapstate(dest_t *dest, int portable);
 	uint write_stackstate(dest_t *dest, int portable);
 	uint read_memstate(dest_t *dest, uint chunklen);
@@ -557,6 +603,19 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Decode the instruction at addr into pd, without evaluating any of its operands.
+	 * Returns false (and leaves pd unused) if the instruction doesn't lie entirely in ROM
+	 * or can't be decoded; such instructions go through parse_operands as usual.
+	 */
+	bool predecode_instruction(predecode_t *pd, uint addr);
+
+	/**
+	 * Same as parse_operands, for an instruction decoded by predecode_instruction. Upon
+	 * return, the PC will be at the beginning of the next instruction.
+	 */
+	void parse_predecoded_operands(oparg_t *opargs, const predecode_t *pd);
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
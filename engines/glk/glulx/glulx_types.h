@@ -352,6 +352,27 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * An instruction in ROM with its opcode and operand modes already decoded, so
+ * executing it again doesn't need them to be parsed. Operands hold the constant
+ * value or the (RAM-adjusted) address that goes with each mode. ROM can't be
+ * written, so these never need to be invalidated.
+ */
+struct predecode_struct {
+	uint pc;                      ///< Address of the instruction, or 0 if the entry is unused
+	uint nextpc;                  ///< Address of the following instruction
+	uint opcode;
+	const operandlist_t *oplist;
+	byte modes[MAX_OPERANDS];
+	uint operands[MAX_OPERANDS];
+};
+typedef predecode_struct predecode_t;
+
+/**
+ * Number of entries in the predecoded instruction cache. Must be a power of two.
+ */
+#define PREDECODE_CACHE_SIZE (0x4000)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -517,6 +517,206 @@ WrLocalsAddr:
 	}
 }
 
+bool Glulx::predecode_instruction(predecode_t *pd, uint addr) {
+	uint start = addr;
+	uint opcode, modeaddr, ix;
+	int numops;
+	const operandlist_t *oplist;
+	int modeval = 0;
+
+	/* The longest possible instruction is a four-byte opcode, four bytes of
+	   modes and eight four-byte operands. Anything that might run past the
+	   end of ROM goes through the normal path instead. */
+	pd->pc = 0;
+	if (addr + 4 + 4 + 4 * MAX_OPERANDS > ramstart)
+		return false;
+
+	opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		if (opcode & 0x40) {
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(addr);
+			opcode = (opcode << 8) | Mem1(addr + 1);
+			opcode = (opcode << 8) | Mem1(addr + 2);
+			addr += 3;
+		} else {
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		}
+	}
+
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
+	if (!oplist)
+		return false;
+
+	numops = oplist->num_ops;
+	modeaddr = addr;
+	addr += (numops + 1) / 2;
+
+	for (ix = 0; (int)ix < numops; ix++) {
+		int mode;
+		uint value = 0;
+
+		if ((ix & 1) == 0) {
+			modeval = Mem1(modeaddr);
+			mode = (modeval & 0x0F);
+		} else {
+			mode = ((modeval >> 4) & 0x0F);
+			modeaddr++;
+		}
+
+		switch (mode) {
+		case 0:
+		case 8:
+			break;
+
+		case 1:
+			value = (int)(signed char)(Mem1(addr));
+			addr++;
+			break;
+		case 2:
+			value = (int)(signed char)(Mem1(addr));
+			value = (value << 8) | (uint)(Mem1(addr + 1));
+			addr += 2;
+			break;
+		case 3:
+			value = Mem4(addr);
+			addr += 4;
+			break;
+
+		case 5:
+		case 9:
+		case 13:
+			value = (uint)(Mem1(addr));
+			addr++;
+			break;
+		case 6:
+		case 10:
+		case 14:
+			value = (uint)Mem2(addr);
+			addr += 2;
+			break;
+		case 7:
+		case 11:
+		case 15:
+			value = Mem4(addr);
+			addr += 4;
+			break;
+
+		default:
+			/* Leave it to parse_operands to complain. */
+			return false;
+		}
+
+		if (mode >= 13)
+			value += ramstart;
+
+		/* Constant addressing mode in a store operand is an error, which
+		   parse_operands reports. */
+		if (oplist->formlist[ix] == modeform_Store && mode >= 1 && mode <= 3)
+			return false;
+
+		pd->modes[ix] = mode;
+		pd->operands[ix] = value;
+	}
+
+	pd->pc = start;
+	pd->nextpc = addr;
+	pd->opcode = opcode;
+	pd->oplist = oplist;
+	return true;
+}
+
+void Glulx::parse_predecoded_operands(oparg_t *args, const predecode_t *pd) {
+	const operandlist_t *oplist = pd->oplist;
+	int numops = oplist->num_ops;
+	int argsize = oplist->arg_size;
+	int ix;
+	oparg_t *curarg;
+
+	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+		uint addr = pd->operands[ix];
+		uint value;
+
+		curarg->desttype = 0;
+
+		if (oplist->formlist[ix] == modeform_Load) {
+			switch (pd->modes[ix]) {
+			case 8: /* pop off stack */
+				if (stackptr < valstackbase + 4) {
+					fatal_error("Stack underflow in operand.");
+				}
+				stackptr -= 4;
+				value = Stk4(stackptr);
+				break;
+
+			case 0:
+			case 1:
+			case 2:
+			case 3: /* constants */
+				value = addr;
+				break;
+
+			case 9:
+			case 10:
+			case 11: /* locals */
+				addr += localsbase;
+				if (argsize == 4) {
+					value = Stk4(addr);
+				} else if (argsize == 2) {
+					value = Stk2(addr);
+				} else {
+					value = Stk1(addr);
+				}
+				break;
+
+			default: /* main memory */
+				if (argsize == 4) {
+					value = Mem4(addr);
+				} else if (argsize == 2) {
+					value = Mem2(addr);
+				} else {
+					value = Mem1(addr);
+				}
+				break;
+			}
+
+			curarg->value = value;
+
+		} else { /* modeform_Store */
+			switch (pd->modes[ix]) {
+			case 0: /* discard value */
+				curarg->value = 0;
+				break;
+
+			case 8: /* push on stack */
+				curarg->desttype = 3;
+				curarg->value = 0;
+				break;
+
+			case 9:
+			case 10:
+			case 11: /* locals, relative to the current locals segment */
+				curarg->desttype = 2;
+				curarg->value = addr;
+				break;
+
+			default: /* main memory */
+				curarg->desttype = 1;
+				curarg->value = addr;
+				break;
+			}
+		}
+	}
+
+	pc = pd->nextpc;
+}
+
 void Glulx::store_operand(uint desttype, uint destaddr, uint storeval) {
 	switch (desttype) {
 
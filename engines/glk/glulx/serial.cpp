@@ -21,18 +21,27 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "common/config-manager.h"
 
 namespace Glk {
 namespace Glulx {
 
 #define IFFID(c1, c2, c3, c4) MKTAG(c1, c2, c3, c4)
 
+/* Undo levels store the RAM in pages of this size. Both ramstart and
+   endmem are always multiples of 256. */
+#define UNDO_PAGE_SIZE (256)
+
 bool Glulx::init_serial() {
 	undo_chain_num = 0;
 	undo_chain_size = max_undo_level;
 	undo_chain = (unsigned char **)glulx_malloc(sizeof(unsigned char *) * undo_chain_size);
 	if (!undo_chain)
 		return false;
+	undo_chain_memory = 0;
+
+	if (ConfMan.hasKey("undo_memory"))
+		max_undo_memory = ConfMan.getInt("undo_memory") * 1024;
 
 #ifdef SERIALIZE_CACHE_RAM
 	{
@@ -63,6 +72,14 @@ void Glulx::final_serial() {
 	undo_chain = nullptr;
 	undo_chain_size = 0;
 	undo_chain_num = 0;
+	undo_chain_memory = 0;
+
+	if (undo_shadow) {
+		glulx_free(undo_shadow);
+		undo_shadow = nullptr;
+	}
+	undo_shadow_len = 0;
+	undo_shadow_alloc = 0;
 
 #ifdef SERIALIZE_CACHE_RAM
 	if (ramcache) {
@@ -72,6 +89,16 @@ void Glulx::final_serial() {
 #endif /* SERIALIZE_CACHE_RAM */
 }
 
+void Glulx::drop_oldest_undo() {
+	byte *ptr = undo_chain[undo_chain_num - 1];
+
+	/* The total size of an undo level is stored at its start. */
+	undo_chain_memory -= Read4(ptr);
+	glulx_free(ptr);
+	undo_chain[undo_chain_num - 1] = nullptr;
+	undo_chain_num -= 1;
+}
+
 uint Glulx::perform_saveundo() {
 	dest_t dest;
 	uint res;
@@ -79,10 +106,14 @@ uint Glulx::perform_saveundo() {
 	uint stackstart = 0, stacklen = 0;
 
 	/* The format for undo-saves is simpler than for saves on disk. We
-	   just have a memory chunk, a heap chunk, and a stack chunk, in
-	   that order. We skip the IFF chunk headers (although the size
-	   fields are still there.) We also don't bother with IFF's 16-bit
-	   alignment. */
+	   have the total size, a memory chunk, a heap chunk, and a stack
+	   chunk, in that order. We skip the IFF chunk headers (although the
+	   size fields are still there.) We also don't bother with IFF's
+	   16-bit alignment.
+
+	   The memory chunk doesn't hold the memory itself. That is kept in
+	   undo_shadow, and the chunk only has the previous contents of the
+	   pages which changed since the last undo save. */
 
 	if (undo_chain_size == 0)
 		return 1;
@@ -90,12 +121,15 @@ uint Glulx::perform_saveundo() {
 	dest._isMem = true;
 
 	res = 0;
+	if (res == 0) {
+		res = write_long(&dest, 0); /* space for the total size */
+	}
 	if (res == 0) {
 		res = write_long(&dest, 0); /* space for chunk length */
 	}
 	if (res == 0) {
 		memstart = dest._pos;
-		res = write_memstate(&dest);
+		res = write_undo_pagediff(&dest);
 		memlen = dest._pos - memstart;
 	}
 	if (res == 0) {
@@ -121,6 +155,12 @@ uint Glulx::perform_saveundo() {
 		if (!dest._ptr)
 			res = 1;
 	}
+	if (res == 0) {
+		res = reposition_write(&dest, 0);
+	}
+	if (res == 0) {
+		res = write_long(&dest, stackstart + stacklen);
+	}
 	if (res == 0) {
 		res = reposition_write(&dest, memstart - 4);
 	}
@@ -142,23 +182,32 @@ uint Glulx::perform_saveundo() {
 
 	if (res == 0) {
 		/* It worked. */
-		if (undo_chain_num >= undo_chain_size) {
-			glulx_free(undo_chain[undo_chain_num - 1]);
-			undo_chain[undo_chain_num - 1] = nullptr;
-		}
+		if (undo_chain_num >= undo_chain_size)
+			drop_oldest_undo();
 		if (undo_chain_size > 1)
 			memmove(undo_chain + 1, undo_chain,
 			        (undo_chain_size - 1) * sizeof(unsigned char *));
 		undo_chain[0] = dest._ptr;
-		if (undo_chain_num < undo_chain_size)
-			undo_chain_num += 1;
+		undo_chain_num += 1;
+		undo_chain_memory += stackstart + stacklen;
 		dest._ptr = nullptr;
+
+		/* Keep within the memory budget, but always keep the level
+		   we just saved. */
+		while (undo_chain_num > 1 && undo_chain_memory + undo_shadow_alloc > max_undo_memory)
+			drop_oldest_undo();
 	} else {
-		/* It didn't work. */
+		/* It didn't work. If the shadow copy was already updated, the
+		   older undo levels no longer match it. */
 		if (dest._ptr) {
 			glulx_free(dest._ptr);
 			dest._ptr = nullptr;
 		}
+		if (memlen) {
+			while (undo_chain_num > 0)
+				drop_oldest_undo();
+			undo_shadow_len = 0;
+		}
 	}
 
 	return res;
@@ -166,9 +215,10 @@ uint Glulx::perform_saveundo() {
 
 uint Glulx::perform_restoreundo() {
 	dest_t dest;
-	uint res, val = 0;
+	uint res, val = 0, newendmem = 0;
 	uint heapsumlen = 0;
 	uint *heapsumarr = nullptr;
+	uint diffstart = 0;
 
 	/* If profiling is enabled and active then fail. */
 #if VM_PROFILING
@@ -183,11 +233,19 @@ uint Glulx::perform_restoreundo() {
 	dest._ptr = undo_chain[0];
 
 	res = 0;
+	if (res == 0) {
+		res = read_long(&dest, &val); /* total size */
+	}
 	if (res == 0) {
 		res = read_long(&dest, &val);
 	}
 	if (res == 0) {
-		res = read_memstate(&dest, val);
+		diffstart = dest._pos;
+		res = read_long(&dest, &newendmem);
+	}
+	if (res == 0) {
+		res = restore_undo_shadow(newendmem);
+		dest._pos = diffstart + val;
 	}
 	if (res == 0) {
 		res = read_long(&dest, &val);
@@ -210,12 +268,17 @@ uint Glulx::perform_restoreundo() {
 	}
 
 	if (res == 0) {
-		/* It worked. */
-		if (undo_chain_size > 1)
-			memmove(undo_chain, undo_chain + 1,
-			        (undo_chain_size - 1) * sizeof(unsigned char *));
-		undo_chain_num -= 1;
-		glulx_free(dest._ptr);
+		/* It worked. Step the shadow copy back to the previous level. */
+		dest._pos = diffstart;
+		res = read_undo_pagediff(&dest);
+		if (res == 0) {
+			undo_chain_memory -= Read4(undo_chain[0]);
+			if (undo_chain_size > 1)
+				memmove(undo_chain, undo_chain + 1,
+				        (undo_chain_size - 1) * sizeof(unsigned char *));
+			undo_chain_num -= 1;
+			glulx_free(dest._ptr);
+		}
 		dest._ptr = nullptr;
 	} else {
 		/* It didn't work. */
@@ -225,6 +288,123 @@ uint Glulx::perform_restoreundo() {
 	return res;
 }
 
+uint Glulx::write_undo_pagediff(dest_t *dest) {
+	uint res, pos, countpos, endpos;
+	uint count = 0;
+	uint memlen = endmem - ramstart;
+	uint prevlen = undo_shadow_len;
+	uint keeplen = undo_chain_num ? undo_shadow_alloc : 0;
+
+	if (memlen > undo_shadow_alloc) {
+		byte *newshadow = (byte *)glulx_realloc(undo_shadow, memlen);
+		if (!newshadow)
+			return 1;
+		undo_shadow = newshadow;
+		undo_shadow_alloc = memlen;
+	}
+
+	res = write_long(dest, endmem);
+	if (res)
+		return res;
+	res = write_long(dest, prevlen);
+	if (res)
+		return res;
+	countpos = dest->_pos;
+	res = write_long(dest, 0); /* space for the page count */
+	if (res)
+		return res;
+
+	for (pos = 0; pos < memlen; pos += UNDO_PAGE_SIZE) {
+		byte *shadowpage = undo_shadow + pos;
+		const byte *mempage = memmap + ramstart + pos;
+
+		if (pos < prevlen && !memcmp(shadowpage, mempage, UNDO_PAGE_SIZE))
+			continue;
+
+		/* Pages past the previous length may still hold the contents of
+		   an older level (if memory shrank and grew again), so those are
+		   kept as well while there are older levels. */
+		if (pos < prevlen || pos < keeplen) {
+			res = write_long(dest, pos);
+			if (!res)
+				res = write_buffer(dest, shadowpage, UNDO_PAGE_SIZE);
+			if (res)
+				return res;
+			count++;
+		}
+
+		memcpy(shadowpage, mempage, UNDO_PAGE_SIZE);
+	}
+	undo_shadow_len = memlen;
+
+	endpos = dest->_pos;
+	res = reposition_write(dest, countpos);
+	if (!res)
+		res = write_long(dest, count);
+	if (!res)
+		res = reposition_write(dest, endpos);
+
+	return res;
+}
+
+uint Glulx::restore_undo_shadow(uint newendmem) {
+	uint res, pos, lx;
+
+	heap_clear();
+
+	res = change_memsize(newendmem, false);
+	if (res)
+		return res;
+
+	if (endmem - ramstart != undo_shadow_len)
+		return 1;
+
+	for (pos = 0; pos < undo_shadow_len; pos += UNDO_PAGE_SIZE) {
+		const byte *shadowpage = undo_shadow + pos;
+		byte *mempage = memmap + ramstart + pos;
+		uint addr = ramstart + pos;
+
+		if (!memcmp(shadowpage, mempage, UNDO_PAGE_SIZE))
+			continue;
+
+		if (addr + UNDO_PAGE_SIZE <= protectstart || addr >= protectend) {
+			memcpy(mempage, shadowpage, UNDO_PAGE_SIZE);
+		} else {
+			for (lx = 0; lx < UNDO_PAGE_SIZE; lx++) {
+				if (addr + lx < protectstart || addr + lx >= protectend)
+					mempage[lx] = shadowpage[lx];
+			}
+		}
+	}
+
+	return 0;
+}
+
+uint Glulx::read_undo_pagediff(dest_t *dest) {
+	uint res, lx, val, prevlen, count, pos;
+
+	res = read_long(dest, &val); /* endmem */
+	if (!res)
+		res = read_long(dest, &prevlen);
+	if (!res)
+		res = read_long(dest, &count);
+	if (res)
+		return res;
+
+	for (lx = 0; lx < count; lx++) {
+		res = read_long(dest, &pos);
+		if (!res && pos + UNDO_PAGE_SIZE > undo_shadow_alloc)
+			res = 1;
+		if (!res)
+			res = read_buffer(dest, undo_shadow + pos, UNDO_PAGE_SIZE);
+		if (res)
+			return res;
+	}
+	undo_shadow_len = prevlen;
+
+	return 0;
+}
+
 Common::Error Glulx::loadGameChunks(QuetzalReader &quetzal) {
 	uint res = 0;
 	uint heapsumlen = 0;
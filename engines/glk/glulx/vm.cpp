@@ -90,6 +90,10 @@ void Glulx::setup_vm() {
 
 	// Initialize various other things in the terp.
 	init_operands();
+	predecode_cache = (predecode_t *)glulx_malloc(PREDECODE_CACHE_SIZE * sizeof(predecode_t));
+	if (!predecode_cache) {
+		fatal_error("Unable to allocate instruction cache.");
+	}
 	init_serial();
 
 	// Set up the initial machine state.
@@ -115,6 +119,10 @@ void Glulx::finalize_vm() {
 		glulx_free(stack);
 		stack = nullptr;
 	}
+	if (predecode_cache) {
+		glulx_free(predecode_cache);
+		predecode_cache = nullptr;
+	}
 
 	final_serial();
 }
@@ -156,6 +164,9 @@ void Glulx::vm_restart() {
 		memmap[lx] = 0;
 	}
 
+	/* ROM has just been reloaded, so forget any instructions decoded from it. */
+	memset(predecode_cache, 0, PREDECODE_CACHE_SIZE * sizeof(predecode_t));
+
 	/* Reset all the registers */
 	stackptr = 0;
 	frameptr = 0;
@@ -30,7 +30,8 @@ namespace ZCode {
 
 Mem::Mem() : story_fp(nullptr), story_size(0), first_undo(nullptr), last_undo(nullptr),
 		curr_undo(nullptr), undo_mem(nullptr), zmp(nullptr), pcp(nullptr), prev_zmp(nullptr),
-		undo_diff(nullptr), undo_count(0), reserve_mem(0) {
+		undo_diff(nullptr), undo_count(0), reserve_mem(0), _textTablesStart(0), _textTablesEnd(0),
+		_textTablesWritten(false) {
 }
 
 void Mem::initialize() {
@@ -202,6 +203,9 @@ void Mem::storeb(zword addr, zbyte value) {
 		flagsChanged(value);
 	}
 
+	if (addr >= _textTablesStart && addr < _textTablesEnd)
+		_textTablesWritten = true;
+
 	SET_BYTE(addr, value);
 }
 
@@ -67,6 +67,11 @@ protected:
 	zbyte *undo_mem, *prev_zmp, *undo_diff;
 	int undo_count;
 	int reserve_mem;
+
+	// Part of dynamic memory holding the text decoding tables, and whether
+	// it may have been written since Processor::check_text_tables looked
+	uint32 _textTablesStart, _textTablesEnd;
+	bool _textTablesWritten;
 private:
 	/**
 	 * Handles setting the story file, parsing it if it's a Blorb file
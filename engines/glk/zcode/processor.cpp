@@ -135,11 +135,15 @@ Opcode Processor::ext_opcodes[64] = {
 Processor::Processor(OSystem *syst, const GlkGameDescription &gameDesc) :
 		GlkInterface(syst, gameDesc),
 		_finished(0), _sp(nullptr), _fp(nullptr), _frameCount(0),
-		zargc(0), _decoded(nullptr), _encoded(nullptr), _resolution(0),
+		zargc(0), _decoded(nullptr), _encoded(nullptr), _resolution(0), _stringCacheChars(0),
+		_stringCapture(nullptr), _textTablesChecked(false),
+		_stringCacheEnabled(false),
 		_randomInterval(0), _randomCtr(0), first_restart(true), script_valid(false),
 		_bufPos(0), _locked(false), _prevC('\0'), script_width(0),
 		sfp(nullptr), rfp(nullptr), pfp(nullptr), ostream_screen(true), ostream_script(false),
-		ostream_memory(false), ostream_record(false), istream_replay(false), message(false) {
+		ostream_memory(false), ostream_record(false), istream_replay(false), message(false),
+		_objectBase(0), _objectSize(0), _maxObject(0), _instructionCount(0), _instructionCacheHits(0),
+		_stringCacheHits(0) {
 	static const Opcode OP0_OPCODES[16] = {
 		&Processor::z_rtrue,
 		&Processor::z_rfalse,
@@ -198,6 +202,10 @@ void Processor::initialize() {
 		op0_opcodes[9] = &Processor::z_catch;
 		op1_opcodes[15] = &Processor::z_call_n;
 	}
+
+	init_objects();
+	_instructionCache.clear();
+	_instructionCache.resize(INSTRUCTION_CACHE_SIZE);
 }
 
 void Processor::load_operand(zbyte type) {
@@ -243,8 +251,101 @@ void Processor::load_all_operands(zbyte specifier) {
 	}
 }
 
+void Processor::decode_instruction(DecodedInstruction &di, uint32 pc) {
+	const zbyte *p = zmp + pc;
+	zbyte opcode = *p++;
+	zbyte specifiers[2];
+	int numSpecifiers = 0;
+
+	di._argc = 0;
+
+	if (opcode < 0x80) {
+		// 2OP opcodes
+		di._types[di._argc++] = (opcode & 0x40) ? 2 : 1;
+		di._types[di._argc++] = (opcode & 0x20) ? 2 : 1;
+		di._handler = var_opcodes[opcode & 0x1f];
+	} else if (opcode < 0xb0) {
+		// 1OP opcodes
+		di._types[di._argc++] = (opcode >> 4) & 3;
+		di._handler = op1_opcodes[opcode & 0x0f];
+	} else if (opcode < 0xc0) {
+		// 0OP opcodes
+		di._handler = op0_opcodes[opcode - 0xb0];
+	} else {
+		// VAR opcodes, where 0xec and 0xfa are call opcodes with up to 8 arguments
+		specifiers[numSpecifiers++] = *p++;
+		if (opcode == 0xec || opcode == 0xfa)
+			specifiers[numSpecifiers++] = *p++;
+
+		for (int s = 0; s < numSpecifiers; ++s) {
+			for (int i = 6; i >= 0; i -= 2) {
+				zbyte type = (specifiers[s] >> i) & 0x03;
+				if (type == 3)
+					break;
+
+				di._types[di._argc++] = type;
+			}
+		}
+		di._handler = var_opcodes[opcode - 0xc0];
+	}
+
+	for (int i = 0; i < di._argc; ++i) {
+		if (di._types[i] & 3) {
+			// small constant, or variable number
+			di._values[i] = *p++;
+		} else {
+			// large constant
+			di._values[i] = READ_BE_UINT16(p);
+			p += 2;
+		}
+	}
+
+	di._pc = pc;
+	di._operandsEnd = p - zmp;
+}
+
+void Processor::load_decoded_operands(const DecodedInstruction &di) {
+	for (int i = 0; i < di._argc; ++i) {
+		zword value = di._values[i];
+
+		if (di._types[i] & 2) {
+			// variable
+			if (value == 0)
+				value = *_sp++;
+			else if (value < 16)
+				value = *(_fp - value);
+			else {
+				zword addr = h_globals + 2 * (value - 16);
+				LOW_WORD(addr, value);
+			}
+		}
+
+		zargs[i] = value;
+	}
+
+	zargc = di._argc;
+	SET_PC(di._operandsEnd);
+}
+
 void Processor::interpret() {
 	do {
+		_instructionCount++;
+
+		// Static memory can't be written to, so instructions in it only need decoding once
+		uint32 pc;
+		GET_PC(pc);
+		if (pc >= h_dynamic_size) {
+			DecodedInstruction &di = _instructionCache[(pc ^ (pc >> 13)) & (INSTRUCTION_CACHE_SIZE - 1)];
+			if (di._pc == pc)
+				_instructionCacheHits++;
+			else
+				decode_instruction(di, pc);
+
+			load_decoded_operands(di);
+			(*this.*di._handler)();
+			continue;
+		}
+
 		zbyte opcode;
 		CODE_BYTE(opcode);
 		zargc = 0;
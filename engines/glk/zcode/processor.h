@@ -26,12 +26,16 @@
 #include "glk/zcode/mem.h"
 #include "glk/zcode/glk_interface.h"
 #include "glk/zcode/frotz_types.h"
+#include "common/hashmap.h"
 #include "common/stack.h"
 
 namespace Glk {
 namespace ZCode {
 
 #define TEXT_BUFFER_SIZE 200
+#define INSTRUCTION_CACHE_SIZE 8192
+#define STRING_CACHE_MAX_CHARS 0x40000
+#define TEXT_TABLES_MAX_SIZE 0x2000
 
 #define CODE_BYTE(v)	   v = codeByte()
 #define CODE_WORD(v)       v = codeWord()
@@ -47,6 +51,30 @@ class Processor;
 class Quetzal;
 typedef void (Processor::*Opcode)();
 
+/**
+ * An instruction in static memory, with its opcode and operand types already decoded
+ */
+struct DecodedInstruction {
+	uint32 _pc;				///< Address of the instruction, or 0 if the entry is unused
+	uint32 _operandsEnd;	///< Address following the operands, where any store or branch data starts
+	Opcode _handler;
+	zbyte _argc;
+	zbyte _types[8];		///< Operand types, as passed to load_operand
+	zword _values[8];		///< Constant values, or variable numbers for variable operands
+
+	DecodedInstruction() : _pc(0), _operandsEnd(0), _handler(nullptr), _argc(0) {}
+};
+
+/**
+ * Text of a string in static memory, as it was passed to print_char when first decoded
+ */
+struct DecodedString {
+	uint32 _end;			///< Address following the encoded string
+	Common::Array<zchar> _text;
+
+	DecodedString() : _end(0) {}
+};
+
 /**
  * Zcode processor
  */
@@ -67,6 +95,9 @@ private:
 	bool first_restart;
 	bool script_valid;
 
+	// Decoded instruction cache
+	Common::Array<DecodedInstruction> _instructionCache;
+
 	// Stack data
 	zword _stack[STACK_SIZE];
 	zword *_sp;
@@ -77,6 +108,12 @@ private:
 	static zchar ZSCII_TO_LATIN1[];
 	zchar *_decoded, *_encoded;
 	int _resolution;
+	Common::HashMap<uint32, DecodedString> _stringCache;
+	size_t _stringCacheChars;
+	Common::Array<zchar> *_stringCapture;
+	Common::Array<zbyte> _textTables;
+	bool _textTablesChecked;
+	bool _stringCacheEnabled;
 	int _errorCount[ERR_NUM_ERRORS];
 
 	// Buffer related fields
@@ -95,7 +132,17 @@ private:
 	bool istream_replay;
 	bool message;
 	Common::FixedStack<Redirect, MAX_NESTING> _redirect;
+
+	// Object table layout
+	zword _objectBase;
+	zword _objectSize;
+	zword _maxObject;
 protected:
+	// Statistics for the instruction and string caches
+	uint32 _instructionCount;
+	uint32 _instructionCacheHits;
+	uint32 _stringCacheHits;
+
 	/**
 	 * \defgroup General support methods
 	 * @{
@@ -112,6 +159,16 @@ protected:
 	 */
 	void load_all_operands(zbyte specifier);
 
+	/**
+	 * Decode the opcode and operand types of the instruction at the given address
+	 */
+	void decode_instruction(DecodedInstruction &di, uint32 pc);
+
+	/**
+	 * Load the operands of a decoded instruction, and move the PC to follow them
+	 */
+	void load_decoded_operands(const DecodedInstruction &di);
+
 	/**
 	 * Call a subroutine. Save PC and FP then load new PC and initialise
 	 * new stack frame. Note that the caller may legally provide less or
@@ -282,6 +339,11 @@ protected:
 	 * @{
 	 */
 
+	/**
+	 * Set up the object table layout used by object_address.
+	 */
+	void init_objects();
+
 	/**
 	 * Calculate the address of an object.
 	 */
@@ -614,6 +676,31 @@ protected:
 	 */
 	void decode_text(string_type st, zword addr);
 
+	/**
+	 * Print a character of decoded text, recording it if a string is being cached
+	 */
+	void print_decoded_char(zchar c);
+
+	/**
+	 * Start a new line from decoded text, recording it if a string is being cached
+	 */
+	void print_decoded_new_line();
+
+	/**
+	 * Print a previously decoded string in static memory, if it's in the string cache.
+	 * For embedded strings the PC is moved past the string.
+	 */
+	bool print_cached_string(string_type st, uint32 byte_addr);
+
+	/**
+	 * Checks the abbreviation, alphabet and Unicode tables that decoding depends on
+	 * haven't changed since the string cache was filled, clearing it if they have.
+	 * They are only compared after a write to them through storeb(), or after
+	 * dynamic memory was replaced by a restart, restore or undo.
+	 * Returns false if the tables are too spread out to be checked cheaply.
+	 */
+	bool check_text_tables();
+
 	/**
 	 * Print a signed 16bit number.
 	 */
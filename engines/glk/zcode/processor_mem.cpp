@@ -103,6 +103,7 @@ int Processor::restore_undo(void) {
 
 	// undo possible
 	memcpy(zmp, prev_zmp, h_dynamic_size);
+	_textTablesWritten = true;
 	SET_PC(curr_undo->pc);
 	_sp = _stack + STACK_SIZE - curr_undo->stack_size;
 	_fp = _stack + curr_undo->frame_offset;
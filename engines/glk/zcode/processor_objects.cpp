@@ -43,9 +43,22 @@ enum O4 {
 	O4_SIZE            = 14
 };
 
+void Processor::init_objects() {
+	// Object numbers start at 1, so the base is one entry before the first object
+	if (h_version <= V3) {
+		_objectSize = O1_SIZE;
+		_objectBase = h_objects + 62 - O1_SIZE;
+		_maxObject = 255;
+	} else {
+		_objectSize = O4_SIZE;
+		_objectBase = h_objects + 126 - O4_SIZE;
+		_maxObject = MAX_OBJECT;
+	}
+}
+
 zword Processor::object_address(zword obj) {
 	// Check object number
-	if (obj > ((h_version <= V3) ? 255 : MAX_OBJECT)) {
+	if (obj > _maxObject) {
 		print_string("@Attempt to address illegal object ");
 		print_num(obj);
 		print_string(".  This is normally fatal.");
@@ -54,10 +67,7 @@ zword Processor::object_address(zword obj) {
 	}
 
 	// Return object address
-	if (h_version <= V3)
-		return h_objects + ((obj - 1) * O1_SIZE + 62);
-	else
-		return h_objects + ((obj - 1) * O4_SIZE + 126);
+	return _objectBase + obj * _objectSize;
 }
 
 zword Processor::object_name(zword object) {
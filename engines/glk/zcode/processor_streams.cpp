@@ -535,6 +535,7 @@ void Processor::z_restart() {
 
 		if (story_fp->read(zmp, h_dynamic_size) != h_dynamic_size)
 			error("Story file read error");
+		_textTablesWritten = true;
 
 	} else {
 		first_restart = false;
@@ -594,6 +595,7 @@ void Processor::z_restore() {
 			strid_t f = glk_stream_open_file(ref, filemode_Read);
 
 			glk_get_buffer_stream(f, (char *)zmp + zargs[0], zargs[1]);
+			_textTablesWritten = true;
 
 			glk_stream_close(f);
 			success = true;
@@ -287,7 +287,105 @@ void Processor::encode_text(int padding) {
 	delete[]  zchars;
 }
 
-#define outchar(c)	if (st == VOCABULARY) *ptr++=c; else print_char(c)
+// Marks a new_line call in the text of a cached string
+static const zchar CACHED_NEW_LINE = 0xffffffff;
+
+void Processor::print_decoded_char(zchar c) {
+	if (_stringCapture)
+		_stringCapture->push_back(c);
+	print_char(c);
+}
+
+void Processor::print_decoded_new_line() {
+	if (_stringCapture)
+		_stringCapture->push_back(CACHED_NEW_LINE);
+	new_line();
+}
+
+bool Processor::check_text_tables() {
+	if (!_textTablesChecked) {
+		// Find the part of dynamic memory holding the abbreviations, alphabet and
+		// Unicode tables, which games could in theory change
+		uint32 start = h_dynamic_size, end = 0;
+
+		if (h_version >= V2 && h_abbreviations) {
+			start = MIN<uint32>(start, h_abbreviations);
+			end = MAX<uint32>(end, h_abbreviations + 2 * 96);
+
+			for (int i = 0; i < 96; ++i) {
+				uint32 addr = 2 * (uint32)READ_BE_UINT16(zmp + h_abbreviations + 2 * i);
+				if (addr >= h_dynamic_size)
+					continue;
+
+				start = MIN(start, addr);
+				while (addr + 2 <= h_dynamic_size && !(zmp[addr] & 0x80))
+					addr += 2;
+				end = MAX(end, addr + 2);
+			}
+		}
+		if (h_alphabet) {
+			start = MIN<uint32>(start, h_alphabet);
+			end = MAX<uint32>(end, h_alphabet + 78);
+		}
+		if (hx_unicode_table) {
+			start = MIN<uint32>(start, hx_unicode_table);
+			end = MAX<uint32>(end, hx_unicode_table + 1 + 2 * zmp[hx_unicode_table]);
+		}
+
+		end = MIN<uint32>(end, h_dynamic_size);
+		_textTablesChecked = true;
+		_textTablesStart = start;
+		_stringCacheEnabled = (end <= start + TEXT_TABLES_MAX_SIZE);
+
+		if (_stringCacheEnabled && end > start) {
+			_textTables.resize(end - start);
+			memcpy(&_textTables[0], zmp + start, _textTables.size());
+			_textTablesEnd = end;
+		}
+		_textTablesWritten = false;
+	}
+
+	if (!_stringCacheEnabled)
+		return false;
+
+	if (!_textTablesWritten)
+		return true;
+	_textTablesWritten = false;
+
+	if (!_textTables.empty() && memcmp(&_textTables[0], zmp + _textTablesStart, _textTables.size())) {
+		// The tables have changed, so everything decoded so far is stale
+		memcpy(&_textTables[0], zmp + _textTablesStart, _textTables.size());
+		_stringCache.clear();
+		_stringCacheChars = 0;
+	}
+
+	return true;
+}
+
+bool Processor::print_cached_string(string_type st, uint32 byte_addr) {
+	if (!check_text_tables())
+		return false;
+
+	Common::HashMap<uint32, DecodedString>::const_iterator i = _stringCache.find(byte_addr);
+	if (i == _stringCache.end())
+		return false;
+
+	const Common::Array<zchar> &text = i->_value._text;
+	for (uint idx = 0; idx < text.size(); ++idx) {
+		if (text[idx] == CACHED_NEW_LINE)
+			new_line();
+		else
+			print_char(text[idx]);
+	}
+
+	if (st == EMBEDDED_STRING)
+		SET_PC(i->_value._end);
+
+	_stringCacheHits++;
+	return true;
+}
+
+#define outchar(c)	if (st == VOCABULARY) *ptr++=c; else print_decoded_char(c)
 
 void Processor::decode_text(enum string_type st, zword addr) {
 	zchar *ptr = nullptr;
@@ -325,6 +423,25 @@ void Processor::decode_text(enum string_type st, zword addr) {
 			runtimeError(ERR_ILL_PRINT_ADDR);
 	}
 
+	// Strings in static memory can't change, so the text printed for them is cached
+	uint32 cache_addr = 0;
+	DecodedString decoded;
+	if (!_stringCapture) {
+		if (st == HIGH_STRING)
+			cache_addr = byte_addr;
+		else if (st == EMBEDDED_STRING)
+			GET_PC(cache_addr);
+
+		if (cache_addr < h_dynamic_size)
+			cache_addr = 0;
+	}
+	if (cache_addr) {
+		if (print_cached_string(st, cache_addr))
+			return;
+		if (_stringCacheEnabled)
+			_stringCapture = &decoded._text;
+	}
+
 	// Loop until a 16bit word has the highest bit set
 	if (st == VOCABULARY)
 		ptr = _decoded;
@@ -358,10 +475,10 @@ void Processor::decode_text(enum string_type st, zword addr) {
 					status = 2;
 
 				else if (h_version == V1 && c == 1)
-					new_line();
+					print_decoded_new_line();
 
 				else if (h_version >= V2 && shift_state == 2 && c == 7)
-					new_line();
+					print_decoded_new_line();
 
 				else if (c >= 6)
 					outchar(alphabet(shift_state, c - 6));
@@ -438,6 +555,21 @@ void Processor::decode_text(enum string_type st, zword addr) {
 
 	if (st == VOCABULARY)
 		*ptr = 0;
+
+	if (cache_addr && _stringCapture == &decoded._text) {
+		_stringCapture = nullptr;
+		if (st == EMBEDDED_STRING)
+			GET_PC(decoded._end);
+		else
+			decoded._end = byte_addr;
+
+		if (_stringCacheChars + decoded._text.size() > STRING_CACHE_MAX_CHARS) {
+			_stringCache.clear();
+			_stringCacheChars = 0;
+		}
+		_stringCacheChars += decoded._text.size();
+		_stringCache[cache_addr] = decoded;
+	}
 }
 
 #undef outchar
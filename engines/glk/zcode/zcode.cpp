@@ -75,8 +75,14 @@ void ZCode::runGame() {
 	}
 
 	// Game loop
+	uint32 startTime = g_system->getMillis();
 	interpret();
 
+	uint32 elapsed = MAX<uint32>(g_system->getMillis() - startTime, 1);
+	debugC(1, kDebugCore, "ZCode: executed %u instructions (%u predecoded) in %u ms, %u instructions/sec, %u cached strings printed",
+		_instructionCount, _instructionCacheHits, elapsed, (uint32)((uint64)_instructionCount * 1000 / elapsed),
+		_stringCacheHits);
+
 	if (!shouldQuit()) {
 		flush_buffer();
 		glk_exit();
@@ -100,6 +106,7 @@ Common::Error ZCode::loadGameState(int slot) {
 
 	Quetzal q(story_fp);
 	bool success = q.restore(*file, this) == 2;
+	_textTablesWritten = true;
 
 	if (success) {
 		zbyte old_screen_rows;
@@ -25,18 +25,26 @@
 #include "common/str.h"
 #include "common/system.h"
 #include "common/util.h"
+#include "common/zlib.h"
 
 #include "scumm/actor.h"
 #include "scumm/boxes.h"
 #include "scumm/debugger.h"
+#include "scumm/file.h"
 #include "scumm/imuse/imuse.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
 #include "scumm/scumm.h"
 #include "scumm/sound.h"
+#ifdef ENABLE_SCUMM_7_8
+#include "scumm/smush/codec37.h"
+#include "scumm/smush/codec47.h"
+#endif
 
 namespace Scumm {
 
+extern const char *nameOfResType(ResType type);
+
 void debugC(int channel, const char *s, ...) {
 	char buf[STRINGBUFLEN];
 	va_list va;
@@ -97,6 +105,12 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("imuse",     WRAP_METHOD(ScummDebugger, Cmd_IMuse));
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+	registerCmd("stripcache",      WRAP_METHOD(ScummDebugger, Cmd_StripCache));
+	registerCmd("resources",       WRAP_METHOD(ScummDebugger, Cmd_Resources));
+#ifdef ENABLE_SCUMM_7_8
+	if (_vm->_game.version >= 7)
+		registerCmd("smushbench",  WRAP_METHOD(ScummDebugger, Cmd_SmushBench));
+#endif
 }
 
 ScummDebugger::~ScummDebugger() {
@@ -845,4 +859,207 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_StripCache(int argc, const char **argv) {
+	Gdi *gdi = _vm->_gdi;
+
+	if (argc == 2 && !strcmp(argv[1], "clear")) {
+		gdi->clearStripCache();
+		gdi->_stripCacheHits = gdi->_stripCacheMisses = 0;
+		debugPrintf("Strip cache cleared\n");
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Syntax: stripcache [clear]\n");
+		return true;
+	}
+
+	const uint32 total = gdi->_stripCacheHits + gdi->_stripCacheMisses;
+	debugPrintf("Strip cache: %u hits, %u misses (%u%% hit rate), %u of %u bytes used\n",
+		gdi->_stripCacheHits, gdi->_stripCacheMisses, total ? gdi->_stripCacheHits * 100 / total : 0,
+		gdi->getStripCacheSize(), Gdi::kStripCacheMaxSize);
+	return true;
+}
+
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	ResourceManager *res = _vm->_res;
+
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		uint32 num = 0, size = 0;
+		for (ResId idx = 0; idx < res->_types[type].size(); idx++) {
+			if (res->_types[type][idx]._address) {
+				num++;
+				size += res->_types[type][idx]._size;
+			}
+		}
+		if (num)
+			debugPrintf("%-12s %4u loaded, %8u bytes\n", nameOfResType(type), num, size);
+	}
+
+	debugPrintf("Total: %u bytes, %u expirable resources with %u bytes\n",
+		res->getAllocatedSize(), res->_lruCount, res->_lruSize);
+	debugPrintf("Expired so far: %u resources with %u bytes\n", res->_expiredCount, res->_expiredSize);
+	return true;
+}
+
+#ifdef ENABLE_SCUMM_7_8
+struct SmushBenchFrame {
+	int codec;
+	int width, height;
+	byte *data;
+};
+
+static void readSmushBenchFrame(Common::Array<SmushBenchFrame> &frames, uint32 type, const byte *ptr, int32 size) {
+	byte *fobj = 0;
+
+	if (type == MKTAG('Z','F','O','B')) {
+#ifdef USE_ZLIB
+		if (size < 4)
+			return;
+		unsigned long decompressedSize = READ_BE_UINT32(ptr);
+		fobj = (byte *)malloc(decompressedSize);
+		if (!Common::uncompress(fobj, &decompressedSize, ptr + 4, size - 4)) {
+			free(fobj);
+			return;
+		}
+		size = (int32)decompressedSize;
+#else
+		return;
+#endif
+	} else {
+		if (size < 14)
+			return;
+		fobj = (byte *)malloc(size);
+		memcpy(fobj, ptr, size);
+	}
+
+	// The frame object header is 14 bytes
+	if (size < 14) {
+		free(fobj);
+		return;
+	}
+
+	SmushBenchFrame frame;
+	frame.codec = READ_LE_UINT16(fobj);
+	frame.width = READ_LE_UINT16(fobj + 6);
+	frame.height = READ_LE_UINT16(fobj + 8);
+	frame.data = fobj;
+
+	if ((frame.codec != 37 && frame.codec != 47) || !frame.width || !frame.height) {
+		free(fobj);
+		return;
+	}
+	frames.push_back(frame);
+}
+
+bool ScummDebugger::Cmd_SmushBench(int argc, const char **argv) {
+	if (argc < 2 || argc > 3) {
+		debugPrintf("Syntax: smushbench <file.san> [iterations]\n");
+		return true;
+	}
+
+	ScummFile file;
+	if (!_vm->openFile(file, argv[1])) {
+		debugPrintf("Could not open file %s\n", argv[1]);
+		return true;
+	}
+
+	const int iterations = (argc == 3) ? MAX(atoi(argv[2]), 1) : 1;
+
+	// Read all codec 37/47 frame objects up front, so that only the
+	// decoding is timed
+	Common::Array<SmushBenchFrame> frames;
+	if (file.readUint32BE() != MKTAG('A','N','I','M')) {
+		debugPrintf("%s is not a SMUSH animation\n", argv[1]);
+		return true;
+	}
+	const int32 animSize = file.readUint32BE();
+
+	while (file.pos() < animSize + 8 && !file.eos()) {
+		const uint32 type = file.readUint32BE();
+		const int32 size = file.readUint32BE();
+		const int32 offset = file.pos();
+		if (size < 0 || file.eos())
+			break;
+
+		if (type == MKTAG('F','R','M','E') && size > 0) {
+			byte *frme = (byte *)malloc(size);
+			if (!frme || file.read(frme, size) != (uint32)size) {
+				free(frme);
+				break;
+			}
+
+			int32 pos = 0;
+			while (pos + 8 <= size) {
+				const uint32 subType = READ_BE_UINT32(frme + pos);
+				const int32 subSize = READ_BE_UINT32(frme + pos + 4);
+				if (subSize < 0 || pos + 8 + subSize > size)
+					break;
+				if (subType == MKTAG('F','O','B','J') || subType == MKTAG('Z','F','O','B'))
+					readSmushBenchFrame(frames, subType, frme + pos + 8, subSize);
+				pos += 8 + subSize + (subSize & 1);
+			}
+			free(frme);
+		}
+
+		file.seek(offset + size, SEEK_SET);
+	}
+
+	if (frames.empty()) {
+		debugPrintf("%s has no codec 37/47 frames\n", argv[1]);
+		return true;
+	}
+
+	uint32 totalTime = 0;
+	for (int i = 0; i < iterations; i++) {
+		Codec37Decoder *codec37 = 0;
+		Codec47Decoder *codec47 = 0;
+		int width37 = 0, height37 = 0;
+		int width47 = 0, height47 = 0;
+		byte *dst = 0;
+		int dstSize = 0;
+
+		const uint32 startTime = _vm->_system->getMillis();
+		for (uint f = 0; f < frames.size(); f++) {
+			const SmushBenchFrame &frame = frames[f];
+			if (frame.width * frame.height > dstSize) {
+				dstSize = frame.width * frame.height;
+				dst = (byte *)realloc(dst, dstSize);
+			}
+
+			// The decoders keep state sized for the frame, so start over
+			// with a new one when the frame size changes
+			if (frame.codec == 37) {
+				if (!codec37 || frame.width != width37 || frame.height != height37) {
+					delete codec37;
+					codec37 = new Codec37Decoder(frame.width, frame.height);
+					width37 = frame.width;
+					height37 = frame.height;
+				}
+				codec37->decode(dst, frame.data + 14);
+			} else {
+				if (!codec47 || frame.width != width47 || frame.height != height47) {
+					delete codec47;
+					codec47 = new Codec47Decoder(frame.width, frame.height);
+					width47 = frame.width;
+					height47 = frame.height;
+				}
+				codec47->decode(dst, frame.data + 14);
+			}
+		}
+		totalTime += _vm->_system->getMillis() - startTime;
+
+		delete codec37;
+		delete codec47;
+		free(dst);
+	}
+
+	for (uint f = 0; f < frames.size(); f++)
+		free(frames[f].data);
+
+	const uint32 decoded = frames.size() * iterations;
+	debugPrintf("Decoded %d frames in %d ms (%d frames per second)\n", decoded, totalTime,
+		totalTime ? decoded * 1000 / totalTime : 0);
+	return true;
+}
+#endif
+
 } // End of namespace Scumm
@@ -69,6 +69,13 @@ private:
 
 	bool Cmd_ResetCursors(int argc, const char **argv);
 
+	bool Cmd_StripCache(int argc, const char **argv);
+	bool Cmd_Resources(int argc, const char **argv);
+
+#ifdef ENABLE_SCUMM_7_8
+	bool Cmd_SmushBench(int argc, const char **argv);
+#endif
+
 	void printBox(int box);
 	void drawBox(int box);
 };
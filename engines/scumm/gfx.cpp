@@ -215,22 +215,35 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+
+	_stripCacheImage = 0;
+	memset(_stripCachePalette, 0, sizeof(_stripCachePalette));
+	_stripCacheHeight = 0;
+	_stripCacheNumZBuf = 0;
+	_stripCacheSize = 0;
+	_stripCacheSupported = true;
+	_stripCacheHits = 0;
+	_stripCacheMisses = 0;
 }
 
 Gdi::~Gdi() {
+	clearStripCache();
 }
 
 GdiHE::GdiHE(ScummEngine *vm) : Gdi(vm), _tmskPtr(0) {
+	_stripCacheSupported = false;
 }
 
 
 GdiNES::GdiNES(ScummEngine *vm) : Gdi(vm) {
 	memset(&_NES, 0, sizeof(_NES));
+	_stripCacheSupported = false;
 }
 
 #ifdef USE_RGB_COLOR
 GdiPCEngine::GdiPCEngine(ScummEngine *vm) : Gdi(vm) {
 	memset(&_PCE, 0, sizeof(_PCE));
+	_stripCacheSupported = false;
 }
 
 GdiPCEngine::~GdiPCEngine() {
@@ -242,10 +255,12 @@ GdiPCEngine::~GdiPCEngine() {
 
 GdiV1::GdiV1(ScummEngine *vm) : Gdi(vm) {
 	memset(&_V1, 0, sizeof(_V1));
+	_stripCacheSupported = false;
 }
 
 GdiV2::GdiV2(ScummEngine *vm) : Gdi(vm) {
 	_roomStrips = 0;
+	_stripCacheSupported = false;
 }
 
 GdiV2::~GdiV2() {
@@ -275,6 +290,7 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	clearStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -1016,7 +1032,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbCacheStrips);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -1824,6 +1840,8 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	const bool useStripCache = (flag & dbCacheStrips) && validateStripCache(ptr, vs, height, numzbuf);
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -1856,7 +1874,22 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		bool cachedStrip = false;
+		bool storeStrip = false;
+		if (useStripCache) {
+			cachedStrip = drawCachedStrip(dstPtr, vs, x, y, height, stripnr);
+			if (cachedStrip)
+				_stripCacheHits++;
+			else
+				_stripCacheMisses++;
+		}
+
+		if (!cachedStrip) {
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+
+			// Transparent strips are drawn over whatever was there before
+			storeStrip = useStripCache && !transpStrip;
+		}
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -1870,7 +1903,11 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (!cachedStrip)
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+		if (storeStrip)
+			storeCachedStrip(dstPtr, vs, x, y, height, stripnr);
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -1898,6 +1935,93 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	}
 }
 
+void Gdi::clearStripCache() {
+	for (uint i = 0; i < _stripCache.size(); i++)
+		free(_stripCache[i]);
+	_stripCache.clear();
+	_stripCacheImage = 0;
+	_stripCacheSize = 0;
+}
+
+bool Gdi::validateStripCache(const byte *ptr, const VirtScreen *vs, int height, int numzbuf) {
+	if (!_stripCacheSupported || vs->number != kMainVirtScreen)
+		return false;
+
+	// Decoded strips depend on the room image, the room palette mapping
+	// and the number of z-planes, so start over whenever one of them changes.
+	if (ptr != _stripCacheImage || height != _stripCacheHeight || numzbuf != _stripCacheNumZBuf ||
+			memcmp(_stripCachePalette, _vm->_roomPalette, sizeof(_stripCachePalette))) {
+		clearStripCache();
+		_stripCacheImage = ptr;
+		_stripCacheHeight = height;
+		_stripCacheNumZBuf = numzbuf;
+		memcpy(_stripCachePalette, _vm->_roomPalette, sizeof(_stripCachePalette));
+	}
+
+	return true;
+}
+
+bool Gdi::drawCachedStrip(byte *dstPtr, const VirtScreen *vs, int x, int y, int height, int stripnr) {
+	if (stripnr < 0 || stripnr >= (int)_stripCache.size() || !_stripCache[stripnr])
+		return false;
+
+	const int stripPitch = 8 * vs->format.bytesPerPixel;
+	const byte *src = _stripCache[stripnr];
+
+	byte *dst = dstPtr;
+	for (int h = 0; h < height; h++) {
+		memcpy(dst, src, stripPitch);
+		dst += vs->pitch;
+		src += stripPitch;
+	}
+
+	for (int i = 1; i < _stripCacheNumZBuf; i++) {
+		byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++)
+			mask_ptr[h * _numStrips] = *src++;
+	}
+
+	return true;
+}
+
+void Gdi::storeCachedStrip(const byte *dstPtr, const VirtScreen *vs, int x, int y, int height, int stripnr) {
+	if (stripnr < 0)
+		return;
+
+	const int stripPitch = 8 * vs->format.bytesPerPixel;
+	const uint32 size = height * (stripPitch + MAX(_stripCacheNumZBuf - 1, 0));
+	if (_stripCacheSize + size > kStripCacheMaxSize)
+		return;
+
+	if (stripnr >= (int)_stripCache.size()) {
+		const uint oldSize = _stripCache.size();
+		_stripCache.resize(stripnr + 1);
+		for (uint i = oldSize; i < _stripCache.size(); i++)
+			_stripCache[i] = 0;
+	}
+	if (_stripCache[stripnr])
+		return;
+
+	byte *dst = (byte *)malloc(size);
+	if (!dst)
+		return;
+	_stripCache[stripnr] = dst;
+	_stripCacheSize += size;
+
+	const byte *src = dstPtr;
+	for (int h = 0; h < height; h++) {
+		memcpy(dst, src, stripPitch);
+		src += vs->pitch;
+		dst += stripPitch;
+	}
+
+	for (int i = 1; i < _stripCacheNumZBuf; i++) {
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++)
+			*dst++ = mask_ptr[h * _numStrips];
+	}
+}
+
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
 	// Do some input verification and make sure the strip/strip offset
@@ -24,6 +24,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -209,6 +210,34 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * Decoded room background strips, indexed by strip number. Each entry
+	 * holds the strip pixels followed by its z-plane masks, or is null if
+	 * the strip hasn't been decoded (or can't be cached).
+	 */
+	Common::Array<byte *> _stripCache;
+	const byte *_stripCacheImage;
+	byte _stripCachePalette[256];
+	int _stripCacheHeight;
+	int _stripCacheNumZBuf;
+	uint32 _stripCacheSize;
+	/** False for the renderers which don't decode strips through drawStrip/decodeMask. */
+	bool _stripCacheSupported;
+
+	bool validateStripCache(const byte *ptr, const VirtScreen *vs, int height, int numzbuf);
+	bool drawCachedStrip(byte *dstPtr, const VirtScreen *vs, int x, int y, int height, int stripnr);
+	void storeCachedStrip(const byte *dstPtr, const VirtScreen *vs, int x, int y, int height, int stripnr);
+
+public:
+	/** Maximum memory used by the decoded room strip cache. */
+	static const uint32 kStripCacheMaxSize = 1024 * 1024;
+
+	uint32 _stripCacheHits;
+	uint32 _stripCacheMisses;
+
+	void clearStripCache();
+	uint32 getStripCacheSize() const { return _stripCacheSize; }
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -282,7 +311,8 @@ public:
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbObjectMode    = 2 << 2,
+		dbCacheStrips   = 1 << 4
 	};
 };
 
@@ -139,8 +139,79 @@ int BundleDirCache::matchFile(const char *filename) {
 	}
 }
 
-BundleMgr::BundleMgr(BundleDirCache *cache) {
+BundleBlockCache::BundleBlockCache() : _useCounter(0) {
+}
+
+BundleBlockCache::~BundleBlockCache() {
+	clear();
+}
+
+bool BundleBlockCache::makeKey(int slot, int32 index, int32 block, uint32 &key) {
+	if (slot < 0 || slot > 3 || index < 0 || index >= 0x4000 || block < 0 || block >= 0x10000)
+		return false;
+
+	key = ((uint32)slot << 30) | ((uint32)index << 16) | (uint32)block;
+	return true;
+}
+
+int32 BundleBlockCache::lookup(int slot, int32 index, int32 block, byte *dst) {
+	uint32 key;
+	if (!makeKey(slot, index, block, key))
+		return -1;
+
+	Common::StackLock lock(_mutex);
+
+	BlockMap::iterator it = _blocks.find(key);
+	if (it == _blocks.end())
+		return -1;
+
+	Block *b = it->_value;
+	b->lastUsed = ++_useCounter;
+	memcpy(dst, b->data, b->size);
+	return b->size;
+}
+
+void BundleBlockCache::store(int slot, int32 index, int32 block, const byte *src, int32 size) {
+	uint32 key;
+	if (!makeKey(slot, index, block, key) || size < 0 || size > kBlockSize)
+		return;
+
+	Common::StackLock lock(_mutex);
+
+	if (_blocks.contains(key))
+		return;
+
+	Block *b;
+	if (_blocks.size() >= kMaxBlocks) {
+		// Reuse the least recently used block
+		BlockMap::iterator oldest = _blocks.begin();
+		for (BlockMap::iterator it = _blocks.begin(); it != _blocks.end(); ++it) {
+			if (it->_value->lastUsed < oldest->_value->lastUsed)
+				oldest = it;
+		}
+		b = oldest->_value;
+		_blocks.erase(oldest);
+	} else {
+		b = new Block;
+	}
+
+	memcpy(b->data, src, size);
+	b->size = size;
+	b->lastUsed = ++_useCounter;
+	_blocks[key] = b;
+}
+
+void BundleBlockCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	for (BlockMap::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+		delete it->_value;
+	_blocks.clear();
+}
+
+BundleMgr::BundleMgr(BundleDirCache *cache, BundleBlockCache *blockCache) {
 	_cache = cache;
+	_blockCache = blockCache;
 	_bundleTable = NULL;
 	_compTable = NULL;
 	_numFiles = 0;
@@ -186,6 +257,7 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 
 	int slot = _cache->matchFile(filename);
 	assert(slot != -1);
+	_fileBundleId = slot;
 	compressed = _cache->isSndDataExtComp(slot);
 	_numFiles = _cache->getNumFiles(slot);
 	assert(_numFiles);
@@ -209,6 +281,7 @@ void BundleMgr::close() {
 		_lastBlock = -1;
 		_outputSize = 0;
 		_curSampleId = -1;
+		_fileBundleId = -1;
 		free(_compTable);
 		_compTable = NULL;
 		free(_compInputBuff);
@@ -288,13 +361,18 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 
 	for (i = firstBlock; i <= lastBlock; i++) {
 		if (_lastBlock != i) {
-			// CMI hack: one more zero byte at the end of input buffer
-			_compInputBuff[_compTable[i].size] = 0;
-			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
-			_file->read(_compInputBuff, _compTable[i].size);
-			_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-			if (_outputSize > 0x2000) {
-				error("_outputSize: %d", _outputSize);
+			_outputSize = _blockCache ? _blockCache->lookup(_fileBundleId, index, i, _compOutputBuff) : -1;
+			if (_outputSize < 0) {
+				// CMI hack: one more zero byte at the end of input buffer
+				_compInputBuff[_compTable[i].size] = 0;
+				_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
+				_file->read(_compInputBuff, _compTable[i].size);
+				_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
+				if (_outputSize > 0x2000) {
+					error("_outputSize: %d", _outputSize);
+				}
+				if (_blockCache)
+					_blockCache->store(_fileBundleId, index, i, _compOutputBuff, _outputSize);
 			}
 			_lastBlock = i;
 		}
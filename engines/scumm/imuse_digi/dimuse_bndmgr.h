@@ -25,6 +25,8 @@
 
 #include "common/scummsys.h"
 #include "common/file.h"
+#include "common/hashmap.h"
+#include "common/mutex.h"
 
 namespace Scumm {
 
@@ -64,6 +66,45 @@ public:
 	bool isSndDataExtComp(int slot);
 };
 
+/**
+ * Decompressed bundle blocks, shared by all BundleMgr instances so that
+ * tracks playing the same bundle entry (e.g. while crossfading) don't
+ * decompress the same blocks again. Blocks are looked up by bundle slot,
+ * file index and block number, and the least recently used ones are
+ * dropped when the cache is full. It's accessed from both the engine and
+ * the iMUSE timer thread, so all access is locked.
+ */
+class BundleBlockCache {
+public:
+	BundleBlockCache();
+	~BundleBlockCache();
+
+	/** Copies a cached block into dst and returns its size, or -1 if it isn't cached. */
+	int32 lookup(int slot, int32 index, int32 block, byte *dst);
+	void store(int slot, int32 index, int32 block, const byte *src, int32 size);
+	void clear();
+
+private:
+	enum {
+		kBlockSize = 0x2000,
+		kMaxBlocks = 256
+	};
+
+	struct Block {
+		byte data[kBlockSize];
+		int32 size;
+		uint32 lastUsed;
+	};
+
+	typedef Common::HashMap<uint32, Block *> BlockMap;
+
+	BlockMap _blocks;
+	uint32 _useCounter;
+	Common::Mutex _mutex;
+
+	static bool makeKey(int slot, int32 index, int32 block, uint32 &key);
+};
+
 class BundleMgr {
 
 private:
@@ -75,6 +116,7 @@ private:
 	};
 
 	BundleDirCache *_cache;
+	BundleBlockCache *_blockCache;
 	BundleDirCache::AudioTable *_bundleTable;
 	BundleDirCache::IndexNode *_indexTable;
 	CompTable *_compTable;
@@ -94,7 +136,7 @@ private:
 
 public:
 
-	BundleMgr(BundleDirCache *_cache);
+	BundleMgr(BundleDirCache *_cache, BundleBlockCache *blockCache);
 	~BundleMgr();
 
 	bool open(const char *filename, bool &compressed, bool errorFlag = false);
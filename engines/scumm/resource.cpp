@@ -44,8 +44,7 @@ namespace Scumm {
 
 enum {
 	RF_LOCK = 0x80,
-	RF_USAGE = 0x7F,
-	RF_USAGE_MAX = RF_USAGE,
+	RF_USAGE_MAX = 0x7F,
 
 	RS_MODIFIED = 0x10,
 	RF_OFFHEAP = 0x40
@@ -538,12 +537,15 @@ void ResourceManager::allocResTypeData(ResType type, uint32 tag, int num, ResTyp
 	if (num >= 8000)
 		error("Too many %s resources (%d) in directory", nameOfResType(type), num);
 
-	_types[type]._mode = mode;
-	_types[type]._tag = tag;
-
 	// If there was data in there, let's clear it out completely. This is important
 	// in case we are restarting the game.
+	for (ResId idx = 0; idx < _types[type].size(); idx++)
+		nukeResource(type, idx);
 	_types[type].clear();
+
+	_types[type]._mode = mode;
+	_types[type]._tag = tag;
+
 	_types[type].resize(num);
 
 /*
@@ -786,28 +788,77 @@ void ResourceManager::increaseExpireCounter() {
 }
 
 void ResourceManager::increaseResourceCounters() {
-	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-		ResId idx = _types[type].size();
-		while (idx-- > 0) {
-			byte counter = _types[type][idx].getResourceCounter();
-			if (counter && counter < RF_USAGE_MAX) {
-				setResourceCounter(type, idx, counter + 1);
-			}
-		}
-	}
+	// The counters are worked out from the epoch, so this ages every resource at once
+	_expireEpoch++;
 }
 
 void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter) {
-	_types[type][idx].setResourceCounter(counter);
+	Resource &res = _types[type][idx];
+	counter = CLIP<byte>(counter, 1, RF_USAGE_MAX);
+	res._lastUsed = _expireEpoch - (counter - 1);
+
+	if (!res._inLRU)
+		return;
+
+	// Keep the list ordered by age, most recent at the tail
+	lruUnlink(type, idx);
+	uint32 prev = _lruTail;
+	if (counter == RF_USAGE_MAX) {
+		prev = RES_LRU_NONE;
+	} else {
+		while (prev != RES_LRU_NONE && _expireEpoch - lruResource(prev)._lastUsed < (uint32)(counter - 1))
+			prev = lruResource(prev)._lruPrev;
+	}
+	lruInsertAfter(type, idx, prev);
 }
 
-void ResourceManager::Resource::setResourceCounter(byte counter) {
-	_flags &= RF_LOCK;	// Clear lower 7 bits, preserve the lock bit.
-	_flags |= counter;	// Update the usage counter
+byte ResourceManager::getResourceCounter(ResType type, ResId idx) const {
+	const Resource &res = _types[type][idx];
+	if (!res._address)
+		return 0;
+	return MIN<uint32>(_expireEpoch - res._lastUsed + 1, RF_USAGE_MAX);
 }
 
-byte ResourceManager::Resource::getResourceCounter() const {
-	return _flags & RF_USAGE;
+void ResourceManager::lruUnlink(ResType type, ResId idx) {
+	Resource &res = _types[type][idx];
+	assert(res._inLRU);
+
+	if (res._lruPrev != RES_LRU_NONE)
+		lruResource(res._lruPrev)._lruNext = res._lruNext;
+	else
+		_lruHead = res._lruNext;
+	if (res._lruNext != RES_LRU_NONE)
+		lruResource(res._lruNext)._lruPrev = res._lruPrev;
+	else
+		_lruTail = res._lruPrev;
+
+	res._lruPrev = res._lruNext = RES_LRU_NONE;
+	res._inLRU = false;
+	_lruCount--;
+	_lruSize -= res._size;
+}
+
+void ResourceManager::lruInsertAfter(ResType type, ResId idx, uint32 prev) {
+	Resource &res = _types[type][idx];
+	uint32 id = ((uint32)type << 16) | idx;
+	assert(!res._inLRU);
+
+	res._lruPrev = prev;
+	if (prev != RES_LRU_NONE) {
+		res._lruNext = lruResource(prev)._lruNext;
+		lruResource(prev)._lruNext = id;
+	} else {
+		res._lruNext = _lruHead;
+		_lruHead = id;
+	}
+	if (res._lruNext != RES_LRU_NONE)
+		lruResource(res._lruNext)._lruPrev = id;
+	else
+		_lruTail = id;
+
+	res._inLRU = true;
+	_lruCount++;
+	_lruSize += res._size;
 }
 
 /* 2 bytes safety area to make "precaching" of bytes in the gdi drawer easier */
@@ -842,7 +893,11 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
-	setResourceCounter(type, idx, 1);
+	_types[type][idx]._lastUsed = _expireEpoch;
+
+	// Resources that can be reloaded from the data files are candidates for expiring
+	if (_types[type]._mode != kDynamicResTypeMode)
+		lruInsertAfter(type, idx, _lruTail);
 	return ptr;
 }
 
@@ -853,6 +908,9 @@ ResourceManager::Resource::Resource() {
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
+	_lastUsed = 0;
+	_lruPrev = _lruNext = RES_LRU_NONE;
+	_inLRU = false;
 }
 
 ResourceManager::Resource::~Resource() {
@@ -881,6 +939,10 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	_expireEpoch = 0;
+	_lruHead = _lruTail = RES_LRU_NONE;
+	_lruCount = _lruSize = 0;
+	_expiredCount = _expiredSize = 0;
 }
 
 ResourceManager::~ResourceManager() {
@@ -906,6 +968,8 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	byte *ptr = _types[type][idx]._address;
 	if (ptr != NULL) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
+		if (_types[type][idx]._inLRU)
+			lruUnlink(type, idx);
 		_allocatedSize -= _types[type][idx]._size;
 		_types[type][idx].nuke();
 	}
@@ -1042,9 +1106,6 @@ void ResourceManager::Resource::setOnHeap() {
 }
 
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1057,31 +1118,26 @@ void ResourceManager::expireResources(uint32 size) {
 
 	oldAllocatedSize = _allocatedSize;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
-				}
-			}
-		}
-
-		if (!best_type)
+	// Only resources that can be reloaded from the data files are in the list,
+	// and the oldest come first. Those used since the counters were last
+	// increased are never expired.
+	uint32 id = _lruHead;
+	while (id != RES_LRU_NONE && size + _allocatedSize > _minHeapThreshold) {
+		ResType type = ResType(id >> 16);
+		ResId idx = id & 0xFFFF;
+		Resource &tmp = _types[type][idx];
+		uint32 next = tmp._lruNext;
+
+		if (getResourceCounter(type, idx) < 2)
 			break;
-		nukeResource(best_type, best_res);
-	} while (size + _allocatedSize > _minHeapThreshold);
+
+		if (!tmp.isLocked() && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
+			_expiredCount++;
+			_expiredSize += tmp._size;
+			nukeResource(type, idx);
+		}
+		id = next;
+	}
 
 	increaseResourceCounters();
 
@@ -1142,7 +1198,8 @@ void ResourceManager::resourceStats() {
 		}
 	}
 
-	debug(1, "Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
+	debug(1, "Total allocated size=%d, locked=%d(%d), expirable=%d(%d), expired=%d(%d)", _allocatedSize, lockedSize, lockedNum,
+		_lruSize, _lruCount, _expiredSize, _expiredCount);
 }
 
 void ScummEngine_v5::readMAXS(int blockSize) {
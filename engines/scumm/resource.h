@@ -46,7 +46,8 @@ public:
 };
 
 enum {
-	RES_INVALID_OFFSET = 0xFFFFFFFF
+	RES_INVALID_OFFSET = 0xFFFFFFFF,
+	RES_LRU_NONE = 0xFFFFFFFF
 };
 
 class ScummEngine;
@@ -81,6 +82,7 @@ protected:
 
 public:
 	class Resource {
+	friend class ResourceManager;
 	public:
 		/**
 		 * Pointer to the data contained in this resource
@@ -95,15 +97,29 @@ public:
 	protected:
 		/**
 		 * The uppermost bit indicates whether the resources is locked.
-		 * The lower 7 bits contain a counter. This counter measures roughly
-		 * how old the resource is; it starts out with a count of 1 and can go
-		 * as high as 127. When memory falls low resp. when the engine decides
-		 * that it should throw out some unused stuff, then it begins by
-		 * removing the resources with the highest counter (excluding locked
-		 * resources and resources that are known to be in use).
 		 */
 		byte _flags;
 
+		/**
+		 * The value of the resource manager's expire epoch when this resource
+		 * was last used. The difference to the current epoch gives the usage
+		 * counter, which measures roughly how old the resource is; it starts
+		 * out with a count of 1 and can go as high as 127. When memory falls
+		 * low resp. when the engine decides that it should throw out some
+		 * unused stuff, then it begins by removing the resources with the
+		 * highest counter (excluding locked resources and resources that are
+		 * known to be in use).
+		 */
+		uint32 _lastUsed;
+
+		/**
+		 * Neighbours in the resource manager's list of loaded resources that
+		 * can be expired, ordered from least to most recently used. Entries
+		 * are packed as (type << 16) | idx.
+		 */
+		uint32 _lruPrev, _lruNext;
+		bool _inLRU;
+
 		/**
 		 * The status of the resource. Currently only one bit is used, which
 		 * indicates whether the resource is modified.
@@ -132,9 +148,6 @@ public:
 
 		void nuke();
 
-		inline void setResourceCounter(byte counter);
-		inline byte getResourceCounter() const;
-
 		void lock();
 		void unlock();
 		bool isLocked() const;
@@ -176,6 +189,25 @@ protected:
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
 
+	/**
+	 * Incremented each time all resource counters would have been increased,
+	 * so that aging the resources doesn't need to visit each of them.
+	 */
+	uint32 _expireEpoch;
+
+	/**
+	 * Least and most recently used ends of the list of loaded resources that
+	 * can be expired.
+	 */
+	uint32 _lruHead, _lruTail;
+
+public:
+	/**
+	 * Statistics about the expirable resources, shown by the debugger.
+	 */
+	uint32 _lruCount, _lruSize;
+	uint32 _expiredCount, _expiredSize;
+
 public:
 	ResourceManager(ScummEngine *vm);
 	~ResourceManager();
@@ -216,19 +248,30 @@ public:
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
 	/**
-	 * Increment the counter of all unlocked loaded resources.
-	 * The maximal count is 255.
+	 * Get the specified resource's counter.
+	 */
+	byte getResourceCounter(ResType type, ResId idx) const;
+
+	/**
+	 * Increment the counter of all loaded resources.
+	 * The maximal count is 127.
 	 * This is called by increaseExpireCounter and expireResources,
 	 * but also by ScummEngine::startScene.
 	 */
 	void increaseResourceCounters();
 
+	uint32 getAllocatedSize() const { return _allocatedSize; }
+
 	void resourceStats();
 
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
 	void expireResources(uint32 size);
+
+	Resource &lruResource(uint32 id) { return _types[id >> 16][id & 0xFFFF]; }
+	void lruUnlink(ResType type, ResId idx);
+	void lruInsertAfter(ResType type, ResId idx, uint32 prev);
 };
 
 } // End of namespace Scumm
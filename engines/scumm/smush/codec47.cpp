@@ -45,6 +45,12 @@ namespace Scumm {
 		(dst)[1] = (src)[1];	\
 	} while (0)
 
+#define COPY_8X1_LINE(dst, src)			\
+	do {					\
+		COPY_4X1_LINE(dst, src);	\
+		COPY_4X1_LINE((dst) + 4, (src) + 4);	\
+	} while (0)
+
 
 #else /* SCUMM_NEED_ALIGNMENT */
 
@@ -54,6 +60,9 @@ namespace Scumm {
 #define COPY_2X1_LINE(dst, src)			\
 	*(uint16 *)(dst) = *(const uint16 *)(src)
 
+#define COPY_8X1_LINE(dst, src)			\
+	WRITE_UINT64(dst, READ_UINT64(src))
+
 #endif
 
 #define FILL_4X1_LINE(dst, val)			\
@@ -70,6 +79,9 @@ namespace Scumm {
 		(dst)[1] = val;	\
 	} while (0)
 
+#define FILL_8X1_LINE(dst, val)			\
+	WRITE_UINT64(dst, (val) * 0x0101010101010101ULL)
+
 static const  int8 codec47_table_small1[] = {
   0, 1, 2, 3, 3, 3, 3, 2, 1, 0, 0, 0, 1, 2, 2, 1,
 };
@@ -338,6 +350,36 @@ void Codec47Decoder::makeTables47(int width) {
 	} while (c < 32768);
 }
 
+void Codec47Decoder::makeGlyphMasks() {
+	// The glyph pixel lists are stored as (y << 3 | x) for the 8x8 glyphs
+	// and (y << 2 | x) for the 4x4 ones. The second list is drawn after
+	// the first one, so it wins where both cover the same pixel.
+	memset(_glyphMasksBig, 0, 256 * 128);
+	memset(_glyphMasksSmall, 0, 256 * 32);
+
+	for (int g = 0; g < 256; g++) {
+		const byte *glyph = _tableBig + g * 388;
+		byte *mask1 = _glyphMasksBig + g * 128;
+		byte *mask2 = mask1 + 64;
+		for (int d = 0; d < glyph[384]; d++)
+			mask1[glyph[256 + d] & 63] = 0xFF;
+		for (int d = 0; d < glyph[385]; d++) {
+			mask1[glyph[320 + d] & 63] = 0;
+			mask2[glyph[320 + d] & 63] = 0xFF;
+		}
+
+		glyph = _tableSmall + g * 128;
+		mask1 = _glyphMasksSmall + g * 32;
+		mask2 = mask1 + 16;
+		for (int d = 0; d < glyph[96]; d++)
+			mask1[glyph[64 + d] & 15] = 0xFF;
+		for (int d = 0; d < glyph[97]; d++) {
+			mask1[glyph[80 + d] & 15] = 0;
+			mask2[glyph[80 + d] & 15] = 0xFF;
+		}
+	}
+}
+
 #ifdef USE_ARM_SMUSH_ASM
 
 #ifndef IPHONE
@@ -360,6 +402,21 @@ extern "C" void ARM_Smush_decode2(      byte  *dst,
                    _offset1,_offset2,_tableSmall)
 
 #else
+// Sets the pixels of a glyph row to one of two colours, leaving those
+// covered by neither mask alone. The row is handled as a single integer,
+// which gives the same result on any byte order.
+static inline void fillGlyphRow4(byte *dst, const byte *mask1, const byte *mask2, uint32 fill1, uint32 fill2) {
+	const uint32 m1 = READ_UINT32(mask1);
+	const uint32 m2 = READ_UINT32(mask2);
+	WRITE_UINT32(dst, (READ_UINT32(dst) & ~(m1 | m2)) | (fill1 & m1) | (fill2 & m2));
+}
+
+static inline void fillGlyphRow8(byte *dst, const byte *mask1, const byte *mask2, uint64 fill1, uint64 fill2) {
+	const uint64 m1 = READ_UINT64(mask1);
+	const uint64 m2 = READ_UINT64(mask2);
+	WRITE_UINT64(dst, (READ_UINT64(dst) & ~(m1 | m2)) | (fill1 & m1) | (fill2 & m2));
+}
+
 void Codec47Decoder::level3(byte *d_dst) {
 	int32 tmp;
 	byte code = *_d_src++;
@@ -413,20 +470,12 @@ void Codec47Decoder::level2(byte *d_dst) {
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
-		byte *tmp_ptr = _tableSmall + *_d_src++ * 128;
-		int32 l = tmp_ptr[96];
-		byte val = *_d_src++;
-		int16 *tmp_ptr2 = (int16 *)tmp_ptr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
-		}
-		l = tmp_ptr[97];
-		val = *_d_src++;
-		tmp_ptr2 = (int16 *)(tmp_ptr + 32);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
+		const byte *mask = _glyphMasksSmall + *_d_src++ * 32;
+		const uint32 fill1 = *_d_src++ * 0x01010101U;
+		const uint32 fill2 = *_d_src++ * 0x01010101U;
+		for (i = 0; i < 4; i++) {
+			fillGlyphRow4(d_dst, mask + i * 4, mask + 16 + i * 4, fill1, fill2);
+			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFC) {
 		tmp = _offset2;
@@ -444,15 +493,14 @@ void Codec47Decoder::level2(byte *d_dst) {
 }
 
 void Codec47Decoder::level1(byte *d_dst) {
-	int32 tmp, tmp2;
+	int32 tmp2;
 	byte code = *_d_src++;
 	int i;
 
 	if (code < 0xF8) {
 		tmp2 = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFF) {
@@ -466,39 +514,27 @@ void Codec47Decoder::level1(byte *d_dst) {
 	} else if (code == 0xFE) {
 		byte t = *_d_src++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
-		tmp = *_d_src++;
-		byte *tmp_ptr = _tableBig + tmp * 388;
-		byte l = tmp_ptr[384];
-		byte val = *_d_src++;
-		int16 *tmp_ptr2 = (int16 *)tmp_ptr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
-		}
-		l = tmp_ptr[385];
-		val = *_d_src++;
-		tmp_ptr2 = (int16 *)(tmp_ptr + 128);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
+		const byte *mask = _glyphMasksBig + *_d_src++ * 128;
+		const uint64 fill1 = *_d_src++ * 0x0101010101010101ULL;
+		const uint64 fill2 = *_d_src++ * 0x0101010101010101ULL;
+		for (i = 0; i < 8; i++) {
+			fillGlyphRow8(d_dst, mask + i * 8, mask + 64 + i * 8, fill1, fill2);
+			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFC) {
 		tmp2 = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else {
 		byte t = _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	}
@@ -529,9 +565,13 @@ Codec47Decoder::Codec47Decoder(int width, int height) {
 	_height = height;
 	_tableBig = (byte *)malloc(256 * 388);
 	_tableSmall = (byte *)malloc(256 * 128);
+	_glyphMasksBig = (byte *)malloc(256 * 128);
+	_glyphMasksSmall = (byte *)malloc(256 * 32);
 	if ((_tableBig != NULL) && (_tableSmall != NULL)) {
 		makeTablesInterpolation(4);
 		makeTablesInterpolation(8);
+		if ((_glyphMasksBig != NULL) && (_glyphMasksSmall != NULL))
+			makeGlyphMasks();
 	}
 
 	_frameSize = _width * _height;
@@ -551,6 +591,10 @@ Codec47Decoder::~Codec47Decoder() {
 		free(_tableSmall);
 		_tableSmall = NULL;
 	}
+	free(_glyphMasksBig);
+	_glyphMasksBig = NULL;
+	free(_glyphMasksSmall);
+	_glyphMasksSmall = NULL;
 	_lastTableWidth = -1;
 	if (_deltaBuf) {
 		free(_deltaBuf);
@@ -562,7 +606,8 @@ Codec47Decoder::~Codec47Decoder() {
 }
 
 bool Codec47Decoder::decode(byte *dst, const byte *src) {
-	if ((_tableBig == NULL) || (_tableSmall == NULL) || (_deltaBuf == NULL))
+	if ((_tableBig == NULL) || (_tableSmall == NULL) || (_deltaBuf == NULL) ||
+		(_glyphMasksBig == NULL) || (_glyphMasksSmall == NULL))
 		return false;
 
 	_offset1 = _deltaBufs[1] - _curBuf;
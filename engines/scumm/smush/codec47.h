@@ -41,12 +41,17 @@ private:
 	int32 _offset1, _offset2;
 	byte *_tableBig;
 	byte *_tableSmall;
+	// Per glyph row masks of the pixels set to the first and second glyph
+	// colour, so glyph fills can be done a whole row at a time
+	byte *_glyphMasksBig;
+	byte *_glyphMasksSmall;
 	int16 _table[256];
 	int32 _frameSize;
 	int _width, _height;
 
 	void makeTablesInterpolation(int param);
 	void makeTables47(int width);
+	void makeGlyphMasks();
 	void level1(byte *d_dst);
 	void level2(byte *d_dst);
 	void level3(byte *d_dst);
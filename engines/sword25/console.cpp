@@ -22,14 +22,159 @@
 
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/kernel/resmanager.h"
+#include "sword25/package/packagemanager.h"
+#include "sword25/gfx/image/vectorimage.h"
+#include "sword25/script/luascript.h"
+
+#include "common/system.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	registerCmd("resources", WRAP_METHOD(Sword25Console, Cmd_Resources));
+	registerCmd("vectorbench", WRAP_METHOD(Sword25Console, Cmd_VectorBench));
+	registerCmd("luagc", WRAP_METHOD(Sword25Console, Cmd_LuaGC));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+bool Sword25Console::Cmd_Resources(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Usage: %s [budget in KB]\n", argv[0]);
+		return true;
+	}
+
+	ResourceManager *resMan = Kernel::getInstance()->getResourceManager();
+	if (!resMan) {
+		debugPrintf("The resource manager is not initialized\n");
+		return true;
+	}
+
+	if (argc == 2)
+		resMan->setMaxMemoryUsage(atoi(argv[1]) * 1024);
+
+	const ResourceManager::Statistics &stats = resMan->getStatistics();
+	const uint requests = stats.hits + stats.misses;
+
+	debugPrintf("Loaded: %u resources, %u KB of %u KB (peak %u KB)\n", resMan->getResourceCount(),
+	            resMan->getUsedMemory() / 1024, resMan->getMaxMemoryUsage() / 1024, stats.peakMemory / 1024);
+	debugPrintf("Requests: %u hits, %u misses (%u%% hit rate)\n", stats.hits, stats.misses,
+	            requests ? stats.hits * 100 / requests : 0);
+	debugPrintf("Evicted: %u resources, %u KB, %u forcibly unlocked\n", stats.evictions,
+	            stats.evictedBytes / 1024, stats.forcedUnlocks);
+	debugPrintf("Preloaded: %u resources, %u queued\n", stats.preloads, resMan->getPreloadQueueSize());
+	return true;
+}
+
+bool Sword25Console::Cmd_VectorBench(int argc, const char **argv) {
+	if (argc > 3) {
+		debugPrintf("Usage: %s [iterations] [pattern]\n", argv[0]);
+		debugPrintf("Rasterizes the matching vector images at 1x, 2x and 3x their size.\n");
+		debugPrintf("Without a pattern all .swf files up to four directories deep are used.\n");
+		return true;
+	}
+
+	PackageManager *packMan = Kernel::getInstance()->getPackage();
+	if (!packMan) {
+		debugPrintf("The package manager is not initialized\n");
+		return true;
+	}
+
+	const int iterations = (argc >= 2) ? MAX(atoi(argv[1]), 1) : 1;
+
+	Common::ArchiveMemberList list;
+	if (argc == 3) {
+		packMan->doSearch(list, argv[2], "", PackageManager::FT_FILE);
+	} else {
+		Common::String pattern = "/*.swf";
+		for (int depth = 0; depth < 4; depth++) {
+			packMan->doSearch(list, pattern, "", PackageManager::FT_FILE);
+			pattern = "/*" + pattern;
+		}
+	}
+
+	const int kNumScales = 3;
+	uint32 renderTime[kNumScales] = { 0, 0, 0 };
+	uint32 renderedBytes[kNumScales] = { 0, 0, 0 };
+	uint32 parseTime = 0;
+	int images = 0;
+
+	for (Common::ArchiveMemberList::iterator it = list.begin(); it != list.end(); ++it) {
+		Common::String fileName = (*it)->getName();
+		if (!fileName.hasPrefix("/"))
+			fileName = "/" + fileName;
+
+		uint fileSize;
+		byte *fileData = packMan->getFile(fileName, &fileSize);
+		if (!fileData)
+			continue;
+
+		bool success;
+		uint32 start = g_system->getMillis();
+		VectorImage *image = new VectorImage(fileData, fileSize, success, fileName);
+		parseTime += g_system->getMillis() - start;
+		delete[] fileData;
+
+		if (success && image->getWidth() > 0 && image->getHeight() > 0) {
+			for (int s = 0; s < kNumScales; s++) {
+				const int width = image->getWidth() * (s + 1);
+				const int height = image->getHeight() * (s + 1);
+
+				start = g_system->getMillis();
+				for (int i = 0; i < iterations; i++)
+					free(image->render(width, height));
+				renderTime[s] += g_system->getMillis() - start;
+				renderedBytes[s] += width * height * 4;
+			}
+			images++;
+		}
+
+		delete image;
+	}
+
+	debugPrintf("%d vector images, parsed in %u ms\n", images, parseTime);
+	for (int s = 0; s < kNumScales; s++)
+		debugPrintf("%dx: %u ms for %d iterations, %u KB per iteration\n", s + 1, renderTime[s], iterations, renderedBytes[s] / 1024);
+	return true;
+}
+
+bool Sword25Console::Cmd_LuaGC(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Usage: %s [budget in ms per frame]\n", argv[0]);
+		return true;
+	}
+
+	LuaScriptEngine *script = static_cast<LuaScriptEngine *>(Kernel::getInstance()->getScript());
+	if (!script) {
+		debugPrintf("The script engine is not initialized\n");
+		return true;
+	}
+
+	if (argc == 2)
+		script->setGCTimeBudget(atoi(argv[1]));
+
+	const LuaScriptEngine::GCStatistics &stats = script->getGCStatistics();
+
+	debugPrintf("Lua memory: %u KB, collection budget %u ms per frame\n", script->getMemoryUsage(), script->getGCTimeBudget());
+	debugPrintf("Cycles completed in idle time: %u\n", stats.idleCycles);
+	debugPrintf("Duration      Idle slices  Full collections  Automatic steps\n");
+	for (int i = 0; i < LuaScriptEngine::kGCHistogramSize; i++) {
+		Common::String range;
+		if (i == 0)
+			range = "< 1 ms";
+		else if (i == LuaScriptEngine::kGCHistogramSize - 1)
+			range = Common::String::format(">= %d ms", 1 << (i - 1));
+		else
+			range = Common::String::format("%d-%d ms", 1 << (i - 1), (1 << i) - 1);
+
+		debugPrintf("%-12s  %11u  %16u  %15u\n", range.c_str(), stats.idleSlices[i], stats.fullCollections[i], stats.automaticSteps[i]);
+	}
+	return true;
+}
+
 } // End of namespace Sword25
@@ -36,6 +36,10 @@ public:
 
 private:
 	Sword25Engine *_vm;
+
+	bool Cmd_Resources(int argc, const char **argv);
+	bool Cmd_VectorBench(int argc, const char **argv);
+	bool Cmd_LuaGC(int argc, const char **argv);
 };
 
 } // End of namespace Sword25
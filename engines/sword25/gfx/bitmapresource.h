@@ -192,6 +192,10 @@ public:
 		return _pImage->isSolid();
 	}
 
+	uint getMemorySize() const override {
+		return _pImage ? _pImage->getMemorySize() : 0;
+	}
+
 private:
 	Image *_pImage;
 };
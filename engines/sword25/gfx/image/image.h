@@ -71,6 +71,11 @@ public:
 	*/
 	virtual GraphicEngine::COLOR_FORMATS getColorFormat() const = 0;
 
+	/**
+	    @brief Returns the number of bytes of pixel and shape data owned by the image
+	*/
+	virtual uint getMemorySize() const = 0;
+
 	//@}
 
 	//@{
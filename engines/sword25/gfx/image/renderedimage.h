@@ -72,6 +72,10 @@ public:
 	GraphicEngine::COLOR_FORMATS getColorFormat() const override {
 		return GraphicEngine::CF_ARGB32;
 	}
+	uint getMemorySize() const override {
+		// Images created with replaceContent() don't own their pixels
+		return _doCleanup ? _surface.pitch * _surface.h : 0;
+	}
 
 	void copyDirectly(int posX, int posY);
 
@@ -53,6 +53,9 @@ public:
 	GraphicEngine::COLOR_FORMATS getColorFormat() const override {
 		return GraphicEngine::CF_ARGB32;
 	}
+	uint getMemorySize() const override {
+		return _image.pitch * _image.h;
+	}
 
 	bool blit(int posX = 0, int posY = 0,
 	                  int flipping = Graphics::FLIP_NONE,
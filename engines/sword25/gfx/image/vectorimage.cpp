@@ -215,7 +215,7 @@ Common::Rect CalculateBoundingBox(const VectorImageElement &vectorImageElement)
 // Construction
 // -----------------------------------------------------------------------------
 
-VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _fname(fname) {
+VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _fname(fname) {
 	success = false;
 	_bgColor = 0;
 
@@ -312,7 +312,21 @@ VectorImage::~VectorImage() {
 			if (_elements[j].getPathInfo(i).getVec())
 				free(_elements[j].getPathInfo(i).getVec());
 
-	free(_pixelData);
+	for (uint i = 0; i < _renderCache.size(); i++)
+		free(_renderCache[i].pixelData);
+}
+
+uint VectorImage::getMemorySize() const {
+	uint size = 0;
+
+	for (uint i = 0; i < _renderCache.size(); i++)
+		size += _renderCache[i].width * _renderCache[i].height * 4;
+
+	for (uint j = 0; j < _elements.size(); j++)
+		for (uint i = 0; i < _elements[j].getPathCount(); i++)
+			size += _elements[j].getPathInfo(i).getVecLen() * sizeof(ArtBpath);
+
+	return size;
 }
 
 
@@ -610,32 +624,45 @@ bool VectorImage::setContent(const byte *pixeldata, uint size, uint offset, uint
 	return 0;
 }
 
+const byte *VectorImage::getCachedRender(int width, int height) {
+	for (uint i = 0; i < _renderCache.size(); i++) {
+		if (_renderCache[i].width == width && _renderCache[i].height == height) {
+			RenderCacheEntry entry = _renderCache[i];
+			if (i != 0) {
+				_renderCache.remove_at(i);
+				_renderCache.insert_at(0, entry);
+			}
+			return entry.pixelData;
+		}
+	}
+
+	if (_renderCache.size() >= kMaxCachedRenders) {
+		free(_renderCache.back().pixelData);
+		_renderCache.pop_back();
+	}
+
+	RenderCacheEntry entry;
+	entry.width = width;
+	entry.height = height;
+	entry.pixelData = render(width, height);
+	_renderCache.insert_at(0, entry);
+
+	return entry.pixelData;
+}
+
 bool VectorImage::blit(int posX, int posY,
                        int flipping,
                        Common::Rect *pPartRect,
                        uint color,
                        int width, int height,
 					   RectangleList *updateRects) {
-	static VectorImage *oldThis = 0;
-	static int              oldWidth = -2;
-	static int              oldHeight = -2;
-
 	// If width or height to 0, nothing needs to be shown.
 	if (width == 0 || height == 0)
 		return true;
 
-	// Determine if the old image in the cache can not be reused and must be recalculated
-	if (!(oldThis == this && oldWidth == width && oldHeight == height)) {
-		render(width, height);
-
-		oldThis = this;
-		oldHeight = height;
-		oldWidth = width;
-	}
-
 	RenderedImage *rend = new RenderedImage();
 
-	rend->replaceContent(_pixelData, width, height);
+	rend->replaceContent(const_cast<byte *>(getCachedRender(width, height)), width, height);
 	rend->blit(posX, posY, flipping, pPartRect, color, width, height, updateRects);
 
 	delete rend;
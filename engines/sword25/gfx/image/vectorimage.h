@@ -181,9 +181,14 @@ public:
 	GraphicEngine::COLOR_FORMATS getColorFormat() const override {
 		return GraphicEngine::CF_ARGB32;
 	}
+	uint getMemorySize() const override;
 	bool fill(const Common::Rect *pFillRect = 0, uint color = BS_RGB(0, 0, 0)) override;
 
-	void render(int width, int height);
+	/**
+	 * Rasterizes the image at the given size. The returned buffer holds
+	 * width * height ARGB32 pixels and has to be released with free().
+	 */
+	byte *render(int width, int height) const;
 
 	uint getPixel(int x, int y) override;
 	bool isBlitSource() const override {
@@ -225,7 +230,22 @@ private:
 	Common::Array<VectorImageElement>    _elements;
 	Common::Rect                         _boundingBox;
 
-	byte *_pixelData;
+	/**
+	 * Rasterized versions of the image, most recently used first. Scaled
+	 * images are usually drawn at the same few sizes over and over again, so
+	 * keeping a handful of them around saves re-rendering them every frame.
+	 */
+	struct RenderCacheEntry {
+		int width;
+		int height;
+		byte *pixelData;
+	};
+	enum {
+		kMaxCachedRenders = 4
+	};
+	Common::Array<RenderCacheEntry> _renderCache;
+
+	const byte *getCachedRender(int width, int height);
 
 	Common::String _fname;
 	uint _bgColor;
@@ -129,9 +129,14 @@ static int getSubversionRevision(lua_State *L) {
 }
 
 static int getUsedMemory(lua_State *L) {
-	// It doesn't really matter what this call returns,
-	// as it's used in a debug function.
-	lua_pushnumber(L, 0);
+	// This is used in a debug function. Only the memory
+	// occupied by loaded resources is accounted for.
+	Kernel *pKernel = Kernel::getInstance();
+	assert(pKernel);
+	ResourceManager *pResource = pKernel->getResourceManager();
+	assert(pResource);
+
+	lua_pushnumber(L, pResource->getUsedMemory());
 	return 1;
 }
 
@@ -257,7 +262,20 @@ static int processMessages(lua_State *L) {
 	// to the closeWanted() opcode; see also the TODO comment in there.
 
 	lua_pushbooleancpp(L, !Engine::shouldQuit());
-	g_system->delayMillis(10);
+
+	// Spend the idle time of the main loop on resources the scripts
+	// asked to be preloaded, and then on garbage collection
+	const uint32 startTime = g_system->getMillis();
+	Kernel::getInstance()->getResourceManager()->processPreloads(10);
+
+	uint32 elapsed = g_system->getMillis() - startTime;
+	if (elapsed < 10) {
+		Kernel::getInstance()->getScript()->collectGarbage(10 - elapsed);
+		elapsed = g_system->getMillis() - startTime;
+	}
+
+	if (elapsed < 10)
+		g_system->delayMillis(10 - elapsed);
 
 	return 1;
 }
@@ -313,6 +331,7 @@ static int precacheResource(lua_State *L) {
 #ifdef PRECACHE_RESOURCES
 	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1)));
 #else
+	pResource->queuePreload(luaL_checkstring(L, 1));
 	lua_pushbooleancpp(L, true);
 #endif
 
@@ -328,6 +347,8 @@ static int forcePrecacheResource(lua_State *L) {
 #ifdef PRECACHE_RESOURCES
 	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1), true));
 #else
+	// Resources don't change on disk, so preloading is just as good
+	pResource->queuePreload(luaL_checkstring(L, 1));
 	lua_pushbooleancpp(L, true);
 #endif
 
@@ -340,9 +361,7 @@ static int getMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This is used for debugging, so it doesn't really matter.
-	// The default value set by the scripts is 256000000 bytes
-	lua_pushnumber(L, 256000000);
+	lua_pushnumber(L, pResource->getMaxMemoryUsage());
 
 	return 1;
 }
@@ -353,8 +372,8 @@ static int setMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This call is ignored, we set a limit on the number of
-	// simultaneous resources loaded instead.
+	// The default value set by the scripts is 256000000 bytes
+	pResource->setMaxMemoryUsage(static_cast<uint>(luaL_checknumber(L, 1)));
 
 	return 0;
 }
@@ -29,6 +29,8 @@
  *
  */
 
+#include "common/system.h"
+
 #include "sword25/sword25.h"	// for kDebugResource
 #include "sword25/kernel/resmanager.h"
 #include "sword25/kernel/resource.h"
@@ -37,15 +39,20 @@
 
 namespace Sword25 {
 
-// Sets the amount of resources that are simultaneously loaded.
-// This needs to be a relatively high number, as all the animation
-// frames in each scene are loaded as separate resources.
-// Also, George's walk states are all loaded here (150 files)
-#define SWORD25_RESOURCECACHE_MIN 400
-// The maximum number of loaded resources. If more than these resources
-// are loaded, the resource manager will start purging resources till it
-// hits the minimum limit above
-#define SWORD25_RESOURCECACHE_MAX 500
+// The default number of bytes that loaded resources may occupy. The game
+// scripts set their own limit through Resource.SetMaxMemoryUsage().
+// This needs to be relatively high, as all the animation frames in each
+// scene are loaded as separate resources.
+#define SWORD25_RESOURCECACHE_DEFAULT_SIZE (256 * 1024 * 1024)
+// Smaller budgets would keep releasing resources that a scene still needs
+#define SWORD25_RESOURCECACHE_MIN_SIZE (64 * 1024 * 1024)
+
+ResourceManager::ResourceManager(Kernel *pKernel) :
+	_kernelPtr(pKernel),
+	_maxMemoryUsage(SWORD25_RESOURCECACHE_DEFAULT_SIZE),
+	_usedMemory(0) {
+	memset(&_stats, 0, sizeof(_stats));
+}
 
 ResourceManager::~ResourceManager() {
 	// Clear all unlocked resources
@@ -85,33 +92,41 @@ bool ResourceManager::registerResourceService(ResourceService *pService) {
 /**
  * Deletes resources as necessary until the specified memory limit is not being exceeded.
  */
-void ResourceManager::deleteResourcesIfNecessary() {
+void ResourceManager::deleteResourcesIfNecessary(uint incomingSize, bool forceUnlock) {
 	// If enough memory is available, or no resources are loaded, then the function can immediately end
-	if (_resources.size() < SWORD25_RESOURCECACHE_MAX)
+	if (_usedMemory + incomingSize <= _maxMemoryUsage || _resources.empty())
 		return;
 
-	// Keep deleting resources until the memory usage of the process falls below the set maximum limit.
+	// Release a fifth of the budget more than needed, so that the next loads
+	// don't have to go through the list again
+	uint target = _maxMemoryUsage / 5 * 4;
+	target = (incomingSize < target) ? target - incomingSize : 0;
+
+	// Keep deleting resources until the memory usage falls below the target.
 	// The list is processed backwards in order to first release those resources that have been
 	// not been accessed for the longest
 	Common::List<Resource *>::iterator iter = _resources.end();
-	do {
+	while (iter != _resources.begin() && _usedMemory > target) {
 		--iter;
 
 		// The resource may be released only if it isn't locked
-		if ((*iter)->getLockCount() == 0)
+		if ((*iter)->getLockCount() == 0) {
+			++_stats.evictions;
+			_stats.evictedBytes += (*iter)->_memorySize;
 			iter = deleteResource(*iter);
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
+		}
+	}
 
-	// Are we still above the minimum? If yes, then start releasing locked resources
+	// Are we still above the target? If yes, then start releasing locked resources
 	// FIXME: This code shouldn't be needed at all, but it seems like there is a bug
 	// in the resource lock code, and resources are not unlocked when changing rooms.
 	// Only image/animation resources are unlocked forcibly, thus this shouldn't have
 	// any impact on the game itself.
-	if (_resources.size() <= SWORD25_RESOURCECACHE_MIN)
+	if (_usedMemory <= target || !forceUnlock)
 		return;
 
 	iter = _resources.end();
-	do {
+	while (iter != _resources.begin() && _usedMemory > target) {
 		--iter;
 
 		// Only unlock image/animation resources
@@ -124,9 +139,35 @@ void ResourceManager::deleteResourcesIfNecessary() {
 			while ((*iter)->getLockCount() > 0)
 				(*iter)->release();
 
+			++_stats.forcedUnlocks;
+			++_stats.evictions;
+			_stats.evictedBytes += (*iter)->_memorySize;
 			iter = deleteResource(*iter);
 		}
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
+	}
+}
+
+void ResourceManager::updateMemorySize(Resource *pResource) {
+	const uint size = pResource->getMemorySize();
+
+	_usedMemory = _usedMemory - pResource->_memorySize + size;
+	pResource->_memorySize = size;
+
+	if (_usedMemory > _stats.peakMemory)
+		_stats.peakMemory = _usedMemory;
+}
+
+void ResourceManager::setMaxMemoryUsage(uint maxMemoryUsage) {
+	if (maxMemoryUsage < SWORD25_RESOURCECACHE_MIN_SIZE) {
+		warning("Resource budget of %u KB is too small, using %u KB", maxMemoryUsage / 1024, SWORD25_RESOURCECACHE_MIN_SIZE / 1024);
+		maxMemoryUsage = SWORD25_RESOURCECACHE_MIN_SIZE;
+	}
+
+	_maxMemoryUsage = maxMemoryUsage;
+
+	// Resources that are still locked are in use, so they are only
+	// released when a new resource needs the room
+	deleteResourcesIfNecessary(0, false);
 }
 
 /**
@@ -172,8 +213,13 @@ Resource *ResourceManager::requestResource(const Common::String &fileName) {
 	// Determine whether the resource is already loaded
 	// If the resource is found, it will be placed at the head of the resource list and returned
 	Resource *pResource = getResource(uniqueFileName);
-	if (!pResource)
+	if (pResource) {
+		++_stats.hits;
+		updateMemorySize(pResource);
+	} else {
+		++_stats.misses;
 		pResource = loadResource(uniqueFileName);
+	}
 	if (pResource) {
 		moveToFront(pResource);
 		(pResource)->addReference();
@@ -220,6 +266,46 @@ bool ResourceManager::precacheResource(const Common::String &fileName, bool forc
 
 #endif
 
+void ResourceManager::queuePreload(const Common::String &fileName) {
+	// Get the absolute path to the file
+	Common::String uniqueFileName = getUniqueFileName(fileName);
+	if (uniqueFileName.empty() || getResource(uniqueFileName))
+		return;
+
+	// Missing files are only reported when the resource is actually requested
+	if (!_kernelPtr->getPackage()->fileExists(uniqueFileName)) {
+		debugC(kDebugResource, "Not preloading missing file \"%s\"", fileName.c_str());
+		return;
+	}
+
+	_preloadQueue.push_back(uniqueFileName);
+}
+
+bool ResourceManager::processPreloads(uint32 timeLimit) {
+	const uint32 startTime = g_system->getMillis();
+
+	while (!_preloadQueue.empty()) {
+		if (g_system->getMillis() - startTime >= timeLimit)
+			break;
+
+		// Preloads must not push out resources that are in use
+		if (_usedMemory >= _maxMemoryUsage) {
+			debugC(kDebugResource, "Resource budget used up, dropping %d preloads", _preloadQueue.size());
+			_preloadQueue.clear();
+			break;
+		}
+
+		Common::String uniqueFileName = _preloadQueue.front();
+		_preloadQueue.pop_front();
+
+		// The resource may have been requested since it was queued
+		if (!getResource(uniqueFileName) && loadResource(uniqueFileName, true))
+			++_stats.preloads;
+	}
+
+	return _preloadQueue.empty();
+}
+
 /**
  * Moves a resource to the top of the resource list
  * @param pResource     The resource
@@ -239,13 +325,10 @@ void ResourceManager::moveToFront(Resource *pResource) {
  * The resource must not already be loaded
  * @param FileName      The unique filename of the resource to be loaded
  */
-Resource *ResourceManager::loadResource(const Common::String &fileName) {
+Resource *ResourceManager::loadResource(const Common::String &fileName, bool preload) {
 	// ResourceService finden, der die Resource laden kann.
 	for (uint i = 0; i < _resourceServices.size(); ++i) {
 		if (_resourceServices[i]->canLoadResource(fileName)) {
-			// If more memory is desired, memory must be released
-			deleteResourcesIfNecessary();
-
 			// Load the resource
 			Resource *pResource = _resourceServices[i]->loadResource(fileName);
 			if (!pResource) {
@@ -253,6 +336,18 @@ Resource *ResourceManager::loadResource(const Common::String &fileName) {
 				return NULL;
 			}
 
+			// A preloaded resource that doesn't fit is not worth releasing others for
+			const uint size = pResource->getMemorySize();
+			if (preload && _usedMemory + size > _maxMemoryUsage) {
+				debugC(kDebugResource, "Not preloading \"%s\", it exceeds the budget", fileName.c_str());
+				delete pResource;
+				return NULL;
+			}
+
+			// If more memory is desired, memory must be released before it is added
+			deleteResourcesIfNecessary(size);
+			updateMemorySize(pResource);
+
 			// Add the resource to the front of the list
 			_resources.push_front(pResource);
 			pResource->_iterator = _resources.begin();
@@ -296,6 +391,8 @@ Common::List<Resource *>::iterator ResourceManager::deleteResource(Resource *pRe
 	// Remove the resource from the hash table
 	_resourceHashMap.erase(pResource->_fileName);
 
+	_usedMemory -= pResource->_memorySize;
+
 	// Delete the resource from the resource list
 	Common::List<Resource *>::iterator result = _resources.erase(pResource->_iterator);
 
@@ -66,6 +66,63 @@ public:
 	bool precacheResource(const Common::String &fileName, bool forceReload = false);
 #endif
 
+	/**
+	 * Queues a resource to be loaded ahead of time. Queued resources are
+	 * decoded by processPreloads() while the main loop is idle, and are kept
+	 * in the cache unlocked, so that they can be evicted again if needed.
+	 * @param FileName      The filename of the resource to be preloaded
+	 */
+	void queuePreload(const Common::String &fileName);
+
+	/**
+	 * Loads queued resources until the queue is empty or the time is up.
+	 * Preloading never releases other resources. Once the budget is used
+	 * up, the rest of the queue is dropped.
+	 * @param TimeLimit     The available time in milliseconds
+	 * @return              Returns true if no more resources are queued
+	 */
+	bool processPreloads(uint32 timeLimit);
+
+	/**
+	 * Sets the number of bytes loaded resources may occupy. When a resource
+	 * would exceed it, the least recently used unlocked resources are released.
+	 * Budgets below 64 MB are raised to 64 MB.
+	 */
+	void setMaxMemoryUsage(uint maxMemoryUsage);
+
+	uint getMaxMemoryUsage() const {
+		return _maxMemoryUsage;
+	}
+
+	/**
+	 * Returns the number of bytes currently occupied by loaded resources
+	 */
+	uint getUsedMemory() const {
+		return _usedMemory;
+	}
+
+	struct Statistics {
+		uint hits;           ///< Requests served from the cache
+		uint misses;         ///< Requests that had to load the resource
+		uint preloads;       ///< Resources loaded ahead of time
+		uint evictions;      ///< Resources released to stay within the budget
+		uint evictedBytes;   ///< Bytes released to stay within the budget
+		uint forcedUnlocks;  ///< Locked resources that had to be released
+		uint peakMemory;     ///< Highest number of bytes occupied so far
+	};
+
+	const Statistics &getStatistics() const {
+		return _stats;
+	}
+
+	uint getResourceCount() const {
+		return _resources.size();
+	}
+
+	uint getPreloadQueueSize() const {
+		return _preloadQueue.size();
+	}
+
 	/**
 	 * Registers a RegisterResourceService. This method is the constructor of
 	 * BS_ResourceService, and thus helps all resource services in the ResourceManager list
@@ -93,9 +150,7 @@ private:
 	 * Creates a new resource manager
 	 * Only the BS_Kernel class can generate copies this class. Thus, the constructor is private
 	 */
-	ResourceManager(Kernel *pKernel) :
-		_kernelPtr(pKernel)
-	{}
+	ResourceManager(Kernel *pKernel);
 	virtual ~ResourceManager();
 
 	/**
@@ -109,8 +164,10 @@ private:
 	 *
 	 * The resource must not already be loaded
 	 * @param FileName      The unique filename of the resource to be loaded
+	 * @param Preload       If true, the resource is discarded rather than
+	 * releasing other resources when it doesn't fit into the budget
 	 */
-	Resource *loadResource(const Common::String &fileName);
+	Resource *loadResource(const Common::String &fileName, bool preload = false);
 
 	/**
 	 * Returns the full path of a given resource filename.
@@ -131,14 +188,27 @@ private:
 
 	/**
 	 * Deletes resources as necessary until the specified memory limit is not being exceeded.
+	 * @param IncomingSize  The size of a resource about to be added
+	 * @param ForceUnlock   Whether locked image and animation resources may be
+	 * released if unlocked ones don't free enough memory
+	 */
+	void deleteResourcesIfNecessary(uint incomingSize = 0, bool forceUnlock = true);
+
+	/**
+	 * Updates the memory usage total with the current size of a resource,
+	 * which can change after loading, e.g. when a vector image is rendered.
 	 */
-	void deleteResourcesIfNecessary();
+	void updateMemorySize(Resource *pResource);
 
 	Kernel *_kernelPtr;
 	Common::Array<ResourceService *> _resourceServices;
 	Common::List<Resource *> _resources;
 	typedef Common::HashMap<Common::String, Resource *> ResMap;
 	ResMap _resourceHashMap;
+	Common::List<Common::String> _preloadQueue;
+	uint _maxMemoryUsage;
+	uint _usedMemory;
+	Statistics _stats;
 };
 
 } // End of namespace Sword25
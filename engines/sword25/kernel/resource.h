@@ -92,6 +92,15 @@ public:
 		return _type;
 	}
 
+	/**
+	 * Returns the number of bytes of data held by the resource.
+	 * The resource manager uses this to keep the cache within its memory budget.
+	 * Small resources that are dominated by their bookkeeping return 0.
+	 */
+	virtual uint getMemorySize() const {
+		return 0;
+	}
+
 protected:
 	virtual ~Resource() {}
 
@@ -99,6 +108,7 @@ private:
 	Common::String _fileName;          ///< The absolute filename
 	uint _refCount;          ///< The number of locks
 	uint _type;              ///< The type of the resource
+	uint _memorySize;        ///< The size accounted for by the resource manager
 	Common::List<Resource *>::iterator _iterator;        ///< Points to the resource position in the LRU list
 };
 
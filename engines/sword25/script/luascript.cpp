@@ -31,6 +31,7 @@
 
 #include "common/memstream.h"
 #include "common/debug-channels.h"
+#include "common/system.h"
 
 #include "sword25/sword25.h"
 #include "sword25/package/packagemanager.h"
@@ -47,10 +48,18 @@
 
 namespace Sword25 {
 
+// Milliseconds the main loop may spend on garbage collection per frame
+#define SWORD25_LUA_GC_DEFAULT_BUDGET 2
+
 LuaScriptEngine::LuaScriptEngine(Kernel *KernelPtr) :
 	ScriptEngine(KernelPtr),
 	_state(0),
-	_pcallErrorhandlerRegistryIndex(0) {
+	_pcallErrorhandlerRegistryIndex(0),
+	_gcTimeBudget(SWORD25_LUA_GC_DEFAULT_BUDGET),
+	_gcIdleThreshold(0),
+	_gcIdleCycleActive(false),
+	_gcStepStartTime(0) {
+	memset(&_gcStats, 0, sizeof(_gcStats));
 }
 
 LuaScriptEngine::~LuaScriptEngine() {
@@ -84,6 +93,9 @@ bool LuaScriptEngine::init() {
 	// Register panic callback function
 	lua_atpanic(_state, panicCB);
 
+	// Time the collector steps Lua runs while scripts allocate
+	lua_setgchook(_state, gcHook, this);
+
 	// Error handler for lua_pcall calls
 	// The code below contains a local error handler function
 	const char errorHandlerCode[] =
@@ -382,12 +394,77 @@ bool pushPermanentsTable(lua_State *L, PERMANENT_TABLE_TYPE tableType) {
 
 } // End of anonymous namespace
 
+void LuaScriptEngine::addToHistogram(uint32 *histogram, uint32 duration) {
+	uint bucket = 0;
+	while (duration > 0 && bucket < kGCHistogramSize - 1) {
+		duration >>= 1;
+		++bucket;
+	}
+
+	++histogram[bucket];
+}
+
+void LuaScriptEngine::gcHook(void *ud, int start) {
+	LuaScriptEngine *engine = static_cast<LuaScriptEngine *>(ud);
+
+	if (start)
+		engine->_gcStepStartTime = g_system->getMillis();
+	else
+		addToHistogram(engine->_gcStats.automaticSteps, g_system->getMillis() - engine->_gcStepStartTime);
+}
+
+uint LuaScriptEngine::getMemoryUsage() const {
+	return _state ? lua_gc(_state, LUA_GCCOUNT, 0) : 0;
+}
+
+void LuaScriptEngine::collectGarbage(uint32 timeLimit) {
+	if (!_state)
+		return;
+
+	timeLimit = MIN(timeLimit, _gcTimeBudget);
+	if (timeLimit == 0)
+		return;
+
+	if (!_gcIdleCycleActive) {
+		if ((uint)lua_gc(_state, LUA_GCCOUNT, 0) < _gcIdleThreshold)
+			return;
+		_gcIdleCycleActive = true;
+	}
+
+	const uint32 startTime = g_system->getMillis();
+	uint32 elapsed;
+	do {
+		// A step size of 0 performs a single basic step of the collector,
+		// and returns 1 once the cycle has been completed
+		if (lua_gc(_state, LUA_GCSTEP, 0)) {
+			_gcIdleCycleActive = false;
+			_gcIdleThreshold = lua_gc(_state, LUA_GCCOUNT, 0) * 3 / 2;
+			++_gcStats.idleCycles;
+			elapsed = g_system->getMillis() - startTime;
+			break;
+		}
+
+		elapsed = g_system->getMillis() - startTime;
+	} while (elapsed < timeLimit);
+
+	addToHistogram(_gcStats.idleSlices, elapsed);
+}
+
+void LuaScriptEngine::fullGarbageCollection() {
+	const uint32 startTime = g_system->getMillis();
+	lua_gc(_state, LUA_GCCOLLECT, 0);
+	addToHistogram(_gcStats.fullCollections, g_system->getMillis() - startTime);
+
+	_gcIdleCycleActive = false;
+	_gcIdleThreshold = lua_gc(_state, LUA_GCCOUNT, 0) * 3 / 2;
+}
+
 bool LuaScriptEngine::persist(OutputPersistenceBlock &writer) {
 	// Empty the Lua stack. pluto_persist() xepects that the stack is empty except for its parameters
 	lua_settop(_state, 0);
 
 	// Garbage Collection erzwingen.
-	lua_gc(_state, LUA_GCCOLLECT, 0);
+	fullGarbageCollection();
 
 	// Permanents-Table is set on the stack
 	// pluto_persist expects these two items on the Lua stack
@@ -442,9 +519,6 @@ void clearGlobalTable(lua_State *L, const char **exceptions) {
 
 	// Pop the Global table from the stack
 	lua_pop(L, 1);
-
-	// Perform garbage collection, so that all removed elements are deleted
-	lua_gc(L, LUA_GCCOLLECT, 0);
 }
 
 } // End of anonymous namespace
@@ -470,12 +544,16 @@ bool LuaScriptEngine::unpersist(InputPersistenceBlock &reader) {
 	};
 	clearGlobalTable(_state, clearExceptionsFirstPass);
 
+	// Perform garbage collection, so that all removed elements are deleted
+	fullGarbageCollection();
+
 	// In the second pass, the Metatables are removed
 	static const char *clearExceptionsSecondPass[] = {
 		"_G",
 		0
 	};
 	clearGlobalTable(_state, clearExceptionsSecondPass);
+	fullGarbageCollection();
 
 	// Persisted Lua data
 	Common::Array<byte> chunkData;
@@ -507,7 +585,7 @@ bool LuaScriptEngine::unpersist(InputPersistenceBlock &reader) {
 	lua_pop(_state, 1);
 
 	// Force garbage collection
-	lua_gc(_state, LUA_GCCOLLECT, 0);
+	fullGarbageCollection();
 
 	return true;
 }
@@ -84,6 +84,14 @@ public:
 	 */
 	void setCommandLine(const Common::StringArray &commandLineParameters) override;
 
+	/**
+	 * Advances the current garbage collection cycle in idle time, so that
+	 * less of it is left to the collector steps triggered while scripts run.
+	 * A new cycle is started early once memory has grown by half the amount
+	 * that would start one automatically.
+	 */
+	void collectGarbage(uint32 timeLimit) override;
+
 	/**
 	 * @remark              The Lua stack is cleared by this method
 	 */
@@ -93,10 +101,56 @@ public:
 	 */
 	bool unpersist(InputPersistenceBlock &reader) override;
 
+	enum {
+		kGCHistogramSize = 8
+	};
+
+	/**
+	 * Durations of the garbage collection work done in idle time, in full
+	 * collections and in the steps Lua triggers itself while scripts run.
+	 * Bucket 0 counts runs below 1 ms, bucket n runs of 2^(n-1) to 2^n - 1 ms,
+	 * and the last bucket everything longer.
+	 */
+	struct GCStatistics {
+		uint32 idleSlices[kGCHistogramSize];
+		uint32 fullCollections[kGCHistogramSize];
+		uint32 automaticSteps[kGCHistogramSize];
+		uint32 idleCycles;
+	};
+
+	const GCStatistics &getGCStatistics() const {
+		return _gcStats;
+	}
+
+	/**
+	 * Sets the time per frame the main loop may spend on garbage collection
+	 */
+	void setGCTimeBudget(uint32 timeBudget) {
+		_gcTimeBudget = timeBudget;
+	}
+	uint32 getGCTimeBudget() const {
+		return _gcTimeBudget;
+	}
+
+	/**
+	 * Returns the memory in use by Lua in KB
+	 */
+	uint getMemoryUsage() const;
+
 private:
 	lua_State *_state;
 	int _pcallErrorhandlerRegistryIndex;
 
+	uint32 _gcTimeBudget;
+	uint _gcIdleThreshold;
+	bool _gcIdleCycleActive;
+	GCStatistics _gcStats;
+	uint32 _gcStepStartTime;
+
+	void fullGarbageCollection();
+	static void addToHistogram(uint32 *histogram, uint32 duration);
+	static void gcHook(void *ud, int start);
+
 	bool registerStandardLibs();
 	bool registerStandardLibExtensions();
 	bool executeBuffer(const byte *data, uint size, const Common::String &name) const;
@@ -84,6 +84,12 @@ public:
 	*/
 	virtual void setCommandLine(const Common::Array<Common::String> &commandLineParameters) = 0;
 
+	/**
+	 * Spends at most the given number of milliseconds on incremental garbage
+	 * collection. This is called by the main loop while it is otherwise idle.
+	 */
+	virtual void collectGarbage(uint32 timeLimit) {}
+
 	bool persist(OutputPersistenceBlock &writer) override = 0;
 	bool unpersist(InputPersistenceBlock &reader) override = 0;
 };
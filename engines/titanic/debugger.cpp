@@ -29,6 +29,7 @@
 #include "titanic/game/movie_tester.h"
 #include "titanic/main_game_window.h"
 #include "titanic/pet_control/pet_control.h"
+#include "titanic/star_control/star_control.h"
 #include "titanic/support/movie.h"
 #include "titanic/titanic.h"
 #include "common/str-array.h"
@@ -45,6 +46,7 @@ Debugger::Debugger(TitanicEngine *vm) : GUI::Debugger(), _vm(vm) {
 	registerCmd("sound",		WRAP_METHOD(Debugger, cmdSound));
 	registerCmd("cheat",        WRAP_METHOD(Debugger, cmdCheat));
 	registerCmd("frame",        WRAP_METHOD(Debugger, cmdFrame));
+	registerCmd("starbench",    WRAP_METHOD(Debugger, cmdStarBench));
 }
 
 int Debugger::strToInt(const char *s) {
@@ -371,4 +373,26 @@ bool Debugger::cmdFrame(int argc, const char **argv) {
 	}
 }
 
+bool Debugger::cmdStarBench(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("starbench [frames]\n");
+		return true;
+	}
+
+	int frames = (argc == 2) ? strToInt(argv[1]) : 200;
+	CTreeItem *root = g_vm->_window->_project;
+	CStarControl *starControl = nullptr;
+	for (CTreeItem *treeItem = root; treeItem && !starControl; treeItem = treeItem->scan(root))
+		starControl = dynamic_cast<CStarControl *>(treeItem);
+
+	if (!starControl) {
+		debugPrintf("The starfield has not been loaded\n");
+		return true;
+	}
+
+	uint32 elapsed = starControl->benchmark(frames);
+	debugPrintf("%d frames in %u ms\n", frames, elapsed);
+	return true;
+}
+
 } // End of namespace Titanic
@@ -65,6 +65,90 @@ CBaseStars::CBaseStars() : _minVal(0.0), _maxVal(1.0), _range(0.0),
 
 void CBaseStars::clear() {
 	_data.clear();
+	positionsChanged();
+}
+
+void CBaseStars::positionsChanged() {
+	_posX.clear();
+	_posY.clear();
+	_posZ.clear();
+}
+
+void CBaseStars::transformStars(const FPose &pose) {
+	const uint count = _data.size();
+
+	if (_posX.size() != count) {
+		_posX.resize(count);
+		_posY.resize(count);
+		_posZ.resize(count);
+		for (uint idx = 0; idx < count; ++idx) {
+			_posX[idx] = _data[idx]._position._x;
+			_posY[idx] = _data[idx]._position._y;
+			_posZ[idx] = _data[idx]._position._z;
+		}
+
+		_viewX.resize(count);
+		_viewY.resize(count);
+		_viewZ.resize(count);
+		_viewDist2.resize(count);
+	}
+
+	const float r1x = pose._row1._x, r1y = pose._row1._y, r1z = pose._row1._z;
+	const float r2x = pose._row2._x, r2y = pose._row2._y, r2z = pose._row2._z;
+	const float r3x = pose._row3._x, r3y = pose._row3._y, r3z = pose._row3._z;
+	const float vx = pose._vector._x, vy = pose._vector._y, vz = pose._vector._z;
+	const float *posX = _posX.data(), *posY = _posY.data(), *posZ = _posZ.data();
+	float *viewX = _viewX.data(), *viewY = _viewY.data(), *viewZ = _viewZ.data();
+	double *viewDist2 = _viewDist2.data();
+
+	// Branch free, so that the compiler is free to vectorize it. The terms
+	// are summed in the same order as the per-star code this replaces, so
+	// the results are unchanged
+	for (uint idx = 0; idx < count; ++idx) {
+		const float x = posX[idx], y = posY[idx], z = posZ[idx];
+		const float tempX = x * r1x + y * r2x + z * r3x + vx;
+		const float tempY = x * r1y + y * r2y + z * r3y + vy;
+		const float tempZ = x * r1z + y * r2z + z * r3z + vz;
+
+		viewX[idx] = tempX;
+		viewY[idx] = tempY;
+		viewZ[idx] = tempZ;
+		viewDist2[idx] = (double)tempY * tempY + (double)tempX * tempX + (double)tempZ * tempZ;
+	}
+}
+
+void CBaseStars::projectStars(int eye, double xOffset, const CSurfaceArea *surfaceArea, double threshold) {
+	const uint count = _data.size();
+	_screenX[eye].resize(count);
+	_screenY.resize(count);
+	_onScreen[eye].resize(count);
+
+	const double MAX_VAL = 1.0e9 * 1.0e9;
+	const FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
+	const double width1 = surfaceArea->_width - 1;
+	const double height1 = surfaceArea->_height - 1;
+	const double xScale = _value1, yScale = _value2;
+	const float *viewX = _viewX.data(), *viewY = _viewY.data(), *viewZ = _viewZ.data();
+	const double *viewDist2 = _viewDist2.data();
+	int *screenX = _screenX[eye].data(), *screenY = _screenY.data();
+	byte *onScreen = _onScreen[eye].data();
+
+	// Clipping is done on the unconverted coordinates. Truncating them gives
+	// a pixel within 0 <= x < width1 exactly when -1 < x < width1. Stars that
+	// are rejected get a dummy depth and position, so the loop stays free of
+	// branches and never converts out of range values
+	for (uint idx = 0; idx < count; ++idx) {
+		const double tempZ = viewZ[idx];
+		const bool inFront = tempZ > threshold && viewDist2[idx] < MAX_VAL;
+		const double z = inFront ? tempZ : 1.0;
+		const double x = ((double)viewX[idx] + xOffset) * xScale / z + centroid._x;
+		const double y = (double)viewY[idx] * yScale / z + centroid._y;
+		const bool visible = inFront && x > -1.0 && x < width1 && y > -1.0 && y < height1;
+
+		screenX[idx] = (int)(visible ? x : 0.0);
+		screenY[idx] = (int)(visible ? y : 0.0);
+		onScreen[idx] = visible;
+	}
 }
 
 void CBaseStars::initialize() {
@@ -165,26 +249,26 @@ void CBaseStars::draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPose pose = camera->getPose();
 	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
-	const double MAX_VAL = 1.0e9 * 1.0e9;
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
 	double minVal = threshold - 9216.0;
-	int width1 = surfaceArea->_width - 1;
-	int height1 = surfaceArea->_height - 1;
-	double *v1Ptr = &_value1, *v2Ptr = &_value2;
-	double tempX, tempY, tempZ, total2;
+	double tempZ, total2;
+
+	transformStars(pose);
+	projectStars(0, 0.0, surfaceArea, threshold);
+	const float *viewZ = _viewZ.data();
+	const double *viewDist2 = _viewDist2.data();
+	const int *screenX = _screenX[0].data(), *screenY = _screenY.data();
+	const byte *onScreen = _onScreen[0].data();
 
 	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
+		tempZ = viewZ[idx];
 		if (tempZ <= minVal)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ; 
+		CBaseStarEntry &entry = _data[idx];
+		const FVector &vector = entry._position;
+		total2 = viewDist2[idx];
 
 		if (total2 < 1.0e12) {
 			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
@@ -192,13 +276,11 @@ void CBaseStars::draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 			continue;
 		}
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
+		if (!onScreen[idx])
 			continue;
 
-		int xStart = (int)(*v1Ptr * tempX / tempZ + centroid._x);
-		int yStart = (int)(*v2Ptr * tempY / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
-			continue;
+		int xStart = screenX[idx];
+		int yStart = screenY[idx];
 
 		double sVal = sqrt(total2);
 		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
@@ -250,26 +332,26 @@ void CBaseStars::draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPose pose = camera->getPose();
 	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
-	const double MAX_VAL = 1.0e9 * 1.0e9;
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
 	double minVal = threshold - 9216.0;
-	int width1 = surfaceArea->_width - 1;
-	int height1 = surfaceArea->_height - 1;
-	double *v1Ptr = &_value1, *v2Ptr = &_value2;
-	double tempX, tempY, tempZ, total2;
+	double tempZ, total2;
+
+	transformStars(pose);
+	projectStars(0, 0.0, surfaceArea, threshold);
+	const float *viewZ = _viewZ.data();
+	const double *viewDist2 = _viewDist2.data();
+	const int *screenX = _screenX[0].data(), *screenY = _screenY.data();
+	const byte *onScreen = _onScreen[0].data();
 
 	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
+		tempZ = viewZ[idx];
 		if (tempZ <= minVal)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
+		CBaseStarEntry &entry = _data[idx];
+		const FVector &vector = entry._position;
+		total2 = viewDist2[idx];
 
 		if (total2 < 1.0e12) {
 			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
@@ -277,13 +359,11 @@ void CBaseStars::draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 			continue;
 		}
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
+		if (!onScreen[idx])
 			continue;
 
-		int xStart = (int)(*v1Ptr * tempX / tempZ + centroid._x);
-		int yStart = (int)(*v2Ptr * tempY / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
-			continue;
+		int xStart = screenX[idx];
+		int yStart = screenY[idx];
 
 		double sVal = sqrt(total2);
 		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
@@ -336,29 +416,29 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPose pose = camera->getPose();
 	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
-	const double MAX_VAL = 1.0e9 * 1.0e9;
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
 	double minVal = threshold - 9216.0;
-	int width1 = surfaceArea->_width - 1;
-	int height1 = surfaceArea->_height - 1;
-	double *v1Ptr = &_value1, *v2Ptr = &_value2;
-	double *v3Ptr = &_value3, *v4Ptr = &_value4;
-	double tempX, tempY, tempZ, total2, sVal;
+	double tempZ, total2, sVal;
 	int xStart, yStart, rgb;
 	uint16 *pixelP;
 
+	transformStars(pose);
+	projectStars(0, _value3, surfaceArea, threshold);
+	projectStars(1, _value4, surfaceArea, threshold);
+	const float *viewZ = _viewZ.data();
+	const double *viewDist2 = _viewDist2.data();
+	const int *screenX1 = _screenX[0].data(), *screenX2 = _screenX[1].data(), *screenY = _screenY.data();
+	const byte *onScreen1 = _onScreen[0].data(), *onScreen2 = _onScreen[1].data();
+
 	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
+		tempZ = viewZ[idx];
 		if (tempZ <= minVal)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
+		CBaseStarEntry &entry = _data[idx];
+		const FVector &vector = entry._position;
+		total2 = viewDist2[idx];
 
 		if (total2 < 1.0e12) {
 			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
@@ -366,14 +446,11 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 			continue;
 		}
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
-			continue;
-
 		// First pixel
-		xStart = (int)((tempX + *v3Ptr) * *v1Ptr / tempZ + centroid._x);
-		yStart = (int)(tempY * *v2Ptr / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
+		if (!onScreen1[idx])
 			continue;
+		xStart = screenX1[idx];
+		yStart = screenY[idx];
 
 		sVal = sqrt(total2);
 		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
@@ -404,10 +481,10 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		}
 
 		// Second pixel
-		xStart = (int)((tempX + *v4Ptr) * *v1Ptr / tempZ + centroid._x);
-		yStart = (int)(tempY * *v2Ptr / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
+		if (!onScreen2[idx])
 			continue;
+		xStart = screenX2[idx];
+		yStart = screenY[idx];
 
 		sVal = sqrt(total2);
 		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
@@ -443,29 +520,29 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPose pose = camera->getPose();
 	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
-	const double MAX_VAL = 1.0e9 * 1.0e9;
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
 	double minVal = threshold - 9216.0;
-	int width1 = surfaceArea->_width - 1;
-	int height1 = surfaceArea->_height - 1;
-	double *v1Ptr = &_value1, *v2Ptr = &_value2, *v3Ptr = &_value3, *v4Ptr = &_value4;
-	double tempX, tempY, tempZ, total2, sVal;
+	double tempZ, total2, sVal;
 	int xStart, yStart, rgb;
 	uint16 *pixelP;
 
-	for (uint idx = 0; idx < _data.size(); ++idx) {
-		const CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
+	transformStars(pose);
+	projectStars(0, _value3, surfaceArea, threshold);
+	projectStars(1, _value4, surfaceArea, threshold);
+	const float *viewZ = _viewZ.data();
+	const double *viewDist2 = _viewDist2.data();
+	const int *screenX1 = _screenX[0].data(), *screenX2 = _screenX[1].data(), *screenY = _screenY.data();
+	const byte *onScreen1 = _onScreen[0].data(), *onScreen2 = _onScreen[1].data();
 
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
+	for (uint idx = 0; idx < _data.size(); ++idx) {
+		tempZ = viewZ[idx];
 		if (tempZ <= minVal)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
+		const CBaseStarEntry &entry = _data[idx];
+		const FVector &vector = entry._position;
+		total2 = viewDist2[idx];
 
 		if (total2 < 1.0e12) {
 			// We're in close proximity to the given star, so draw a closeup of it
@@ -474,14 +551,11 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 			continue;
 		}
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
-			continue;
-
 		// First pixel
-		xStart = (int)((tempX + *v3Ptr) * *v1Ptr / tempZ + centroid._x);
-		yStart = (int)(tempY * *v2Ptr / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
+		if (!onScreen1[idx])
 			continue;
+		xStart = screenX1[idx];
+		yStart = screenY[idx];
 
 		sVal = sqrt(total2);
 		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
@@ -512,10 +586,10 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		}
 
 		// Second pixel
-		xStart = (int)((tempX + *v4Ptr) * *v1Ptr / tempZ + centroid._x);
-		yStart = (int)((tempY * *v2Ptr) / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
+		if (!onScreen2[idx])
 			continue;
+		xStart = screenX2[idx];
+		yStart = screenY[idx];
 
 		sVal = sqrt(total2);
 		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
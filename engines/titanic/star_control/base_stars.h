@@ -35,6 +35,7 @@ namespace Titanic {
 enum StarMode { MODE_STARFIELD = 0, MODE_PHOTO = 1 };
 
 class CCamera;
+class FPose;
 class CStarCloseup;
 class CString;
 class CSurfaceArea;
@@ -74,6 +75,38 @@ struct CStarPosition : public Common::Point {
  */
 class CBaseStars {
 private:
+	/**
+	 * Star positions, kept as separate coordinate arrays so that the
+	 * per-frame camera transform walks contiguous memory
+	 */
+	Common::Array<float> _posX, _posY, _posZ;
+
+	/**
+	 * Camera space positions and squared distances of the stars,
+	 * as calculated by transformStars for the frame being drawn
+	 */
+	Common::Array<float> _viewX, _viewY, _viewZ;
+	Common::Array<double> _viewDist2;
+
+	/**
+	 * Screen positions of the stars for each eye of a stereo pair, as
+	 * calculated by projectStars, and whether they fall on the surface
+	 */
+	Common::Array<int> _screenX[2], _screenY;
+	Common::Array<byte> _onScreen[2];
+private:
+	/**
+	 * Transforms all the stars into camera space for the given pose
+	 */
+	void transformStars(const FPose &pose);
+
+	/**
+	 * Projects the transformed stars onto the surface for one eye, whose
+	 * horizontal offset is given, and clips them against it and the
+	 * front clipping plane
+	 */
+	void projectStars(int eye, double xOffset, const CSurfaceArea *surfaceArea, double threshold);
+
 	void draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
 	void draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
 	void draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
@@ -100,6 +133,11 @@ protected:
 	 * Reset the data for an entry
 	 */
 	void resetEntry(CBaseStarEntry &entry);
+
+	/**
+	 * Must be called after star positions in _data have been changed
+	 */
+	void positionsChanged();
 public:
 	Common::Array<CBaseStarEntry> _data;
 public:
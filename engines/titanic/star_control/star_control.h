@@ -108,6 +108,11 @@ public:
 	 * Updates the camerea for the star view
 	 */
 	void updateCamera() { _view.updateCamera(); }
+
+	/**
+	 * Times rendering the starfield for a given number of frames
+	 */
+	uint32 benchmark(int frames) { return _view.benchmark(frames); }
 };
 
 } // End of namespace Titanic
@@ -514,6 +514,56 @@ void CStarView::getRandomPhotoViewpoint(FVector &pos, FVector &orientation) {
 	orientation.normalize();
 }
 
+uint32 CStarView::benchmark(int frames) {
+	CScreenManager *scrManager = CScreenManager::setCurrent();
+	if (!_starField || !scrManager || _starField->size() == 0)
+		return 0;
+
+	CVideoSurface *surface = nullptr;
+	resizeSurface(scrManager, 600, 340, &surface);
+	if (!surface)
+		return 0;
+
+	// The flight goes from the sun past two stars and back again
+	const int count = _starField->size();
+	FVector waypoints[4];
+	waypoints[1] = _starField->getDataPtr(count / 3)->_position;
+	waypoints[2] = _starField->getDataPtr(count * 2 / 3)->_position;
+
+	CViewport viewport;
+	CCamera camera(&viewport);
+	uint32 startTime = g_system->getMillis();
+
+	for (int frame = 0; frame < frames; ++frame) {
+		bool stereoPair = frame >= frames / 2;
+		viewport.changeStarColorPixel(MODE_PHOTO, stereoPair ? 30.0 : 0.0);
+		viewport.changeStarColorPixel(MODE_STARFIELD, stereoPair ? 28000.0 : 0.0);
+
+		int pathFrames = stereoPair ? frames - frames / 2 : frames / 2;
+		int pathFrame = stereoPair ? frame - frames / 2 : frame;
+		float t = (float)pathFrame * 3 / MAX(pathFrames, 1);
+		int leg = MIN((int)t, 2);
+		t -= leg;
+
+		FVector dir = waypoints[leg + 1] - waypoints[leg];
+		float hyp;
+		viewport.setPosition(waypoints[leg] + dir * t);
+		if (dir.normalize(hyp))
+			viewport.setOrientation(dir);
+		camera.setViewport(&viewport);
+
+		surface->clear();
+		surface->lock();
+		_starField->render(surface, &camera);
+		surface->unlock();
+	}
+
+	uint32 elapsed = g_system->getMillis() - startTime;
+	delete surface;
+
+	return elapsed;
+}
+
 void CStarView::resizeSurface(CScreenManager *scrManager, int width, int height,
 		CVideoSurface **surface) {
 	if (!surface)
@@ -217,6 +217,13 @@ public:
 	 * Handles unlocking a star
 	 */
 	void unlockStar();
+
+	/**
+	 * Renders the starfield offscreen along a fixed flight path, first
+	 * normally and then as a stereo pair, and returns the time taken
+	 * in milliseconds
+	 */
+	uint32 benchmark(int frames);
 };
 
 } // End of namespace Titanic
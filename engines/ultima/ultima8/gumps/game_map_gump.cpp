@@ -418,6 +418,10 @@ void GameMapGump::IncSortOrder(int count) {
 	else _displayList->DecSortLimit();
 }
 
+uint32 GameMapGump::BenchmarkSortOrder(int iterations, uint32 &itemCount) {
+	return _displayList->BenchmarkDisplayList(iterations, itemCount);
+}
+
 bool GameMapGump::StartDraggingItem(Item *item, int mx, int my) {
 //	ParentToGump(mx, my);
 
@@ -77,6 +77,7 @@ public:
 	void        onMouseDouble(int button, int32 mx, int32 my) override;
 
 	void IncSortOrder(int count);
+	uint32 BenchmarkSortOrder(int iterations, uint32 &itemCount);
 
 	bool loadData(Common::ReadStream *rs, uint32 version);
 	void saveData(Common::WriteStream *ws) override;
@@ -26,6 +26,7 @@
 #include "ultima/ultima8/misc/id_man.h"
 #include "ultima/shared/std/containers.h"
 #include "ultima/ultima8/ultima8.h"
+#include "common/system.h"
 
 namespace Ultima {
 namespace Ultima8 {
@@ -37,11 +38,15 @@ Kernel::Kernel() : _loading(false) {
 
 	_kernel = this;
 	_pIDs = new idMan(1, 32766, 128);
+	_pidTable.resize(32767);
 	current_process = _processes.end();
 	_frameNum = 0;
 	_paused = 0;
 	_runningProcess = nullptr;
 	_frameByFrame = false;
+	_statFrames = 0;
+	_statProcessesRun = 0;
+	_statRunTime = 0;
 }
 
 Kernel::~Kernel() {
@@ -51,6 +56,8 @@ Kernel::~Kernel() {
 	_kernel = nullptr;
 
 	delete _pIDs;
+
+	Process::clearPool();
 }
 
 void Kernel::reset() {
@@ -62,6 +69,10 @@ void Kernel::reset() {
 	_processes.clear();
 	current_process = _processes.begin();
 
+	for (unsigned int i = 0; i < _pidTable.size(); ++i)
+		_pidTable[i] = nullptr;
+	_itemProcesses.clear();
+
 	_pIDs->clearAll();
 
 	_paused = 0;
@@ -81,6 +92,37 @@ ProcId Kernel::assignPID(Process *proc) {
 	return proc->_pid;
 }
 
+void Kernel::indexProcess(Process *proc) {
+	if (proc->_pid < _pidTable.size())
+		_pidTable[proc->_pid] = proc;
+
+	if (proc->_itemNum)
+		_itemProcesses[proc->_itemNum].push_back(proc);
+}
+
+void Kernel::unindexProcess(Process *proc) {
+	if (proc->_pid < _pidTable.size() && _pidTable[proc->_pid] == proc)
+		_pidTable[proc->_pid] = nullptr;
+
+	if (proc->_itemNum) {
+		// The (possibly empty) list is kept, as the item is likely to get
+		// processes again
+		Std::vector<Process *> &procs = _itemProcesses[proc->_itemNum];
+		for (Std::vector<Process *>::iterator it = procs.begin(); it != procs.end(); ++it) {
+			if (*it == proc) {
+				procs.erase(it);
+				break;
+			}
+		}
+	}
+}
+
+void Kernel::setProcessItemNum(Process *proc, ObjId item) {
+	unindexProcess(proc);
+	proc->_itemNum = item;
+	indexProcess(proc);
+}
+
 ProcId Kernel::addProcess(Process *proc) {
 #if 0
 	for (ProcessIterator it = processes.begin(); it != processes.end(); ++it) {
@@ -119,6 +161,7 @@ ProcId Kernel::addProcessExec(Process *proc) {
 
 	_processes.push_back(proc);
 	proc->_flags |= Process::PROC_ACTIVE;
+	indexProcess(proc);
 
 	Process *oldrunning = _runningProcess;
 	_runningProcess = proc;
@@ -143,6 +186,7 @@ void Kernel::removeProcess(Process *proc) {
 			perr << "[Kernel] Removing process " << proc << Std::endl;
 
 			_processes.erase(it);
+			unindexProcess(proc);
 
 			// Clear pid
 			_pIDs->clearID(proc->_pid);
@@ -166,6 +210,8 @@ void Kernel::runProcesses() {
 		exit(0);
 		*/
 	}
+	const uint32 startTime = g_system->getMillis();
+
 	current_process = _processes.begin();
 	while (current_process != _processes.end()) {
 		Process *p = *current_process;
@@ -184,10 +230,12 @@ void Kernel::runProcesses() {
 				return; // If this happens then the list was reset so leave NOW!
 
 			_runningProcess = nullptr;
+			_statProcessesRun++;
 		}
 		if (!_paused && (p->_flags & Process::PROC_TERMINATED)) {
 			// process is killed, so remove it from the list
 			current_process = _processes.erase(current_process);
+			unindexProcess(p);
 
 			// Clear pid
 			_pIDs->clearID(p->_pid);
@@ -198,6 +246,9 @@ void Kernel::runProcesses() {
 			++current_process;
 	}
 
+	_statRunTime += g_system->getMillis() - startTime;
+	_statFrames++;
+
 	if (!_paused && _frameByFrame) pause();
 }
 
@@ -205,15 +256,20 @@ void Kernel::setNextProcess(Process *proc) {
 	if (current_process != _processes.end() && *current_process == proc) return;
 
 	if (proc->_flags & Process::PROC_ACTIVE) {
+		bool found = false;
 		for (ProcessIterator it = _processes.begin();
 		        it != _processes.end(); ++it) {
 			if (*it == proc) {
 				_processes.erase(it);
+				found = true;
 				break;
 			}
 		}
+		if (!found)
+			indexProcess(proc);
 	} else {
 		proc->_flags |= Process::PROC_ACTIVE;
+		indexProcess(proc);
 	}
 
 	if (current_process == _processes.end()) {
@@ -227,6 +283,9 @@ void Kernel::setNextProcess(Process *proc) {
 }
 
 Process *Kernel::getProcess(ProcId pid) {
+	if (pid < _pidTable.size())
+		return _pidTable[pid];
+
 	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
 		Process *p = *it;
 		if (p->_pid == pid)
@@ -238,6 +297,19 @@ Process *Kernel::getProcess(ProcId pid) {
 void Kernel::kernelStats() {
 	g_debugger->debugPrintf("Kernel memory stats:\n");
 	g_debugger->debugPrintf("Processes  : %u/32765\n", _processes.size());
+
+	uint32 allocated, reused, pooled;
+	Process::getPoolStats(allocated, reused, pooled);
+	g_debugger->debugPrintf("Pool       : %u allocated, %u reused, %u free\n",
+	                        allocated, reused, pooled);
+
+	g_debugger->debugPrintf("Scheduling : %u processes run in %u frames, %u ms\n",
+	                        _statProcessesRun, _statFrames, _statRunTime);
+	if (_statFrames) {
+		g_debugger->debugPrintf("Per frame  : %.1f processes, %.3f ms\n",
+		                        (double)_statProcessesRun / _statFrames,
+		                        (double)_statRunTime / _statFrames);
+	}
 }
 
 void Kernel::processTypes() {
@@ -256,6 +328,20 @@ void Kernel::processTypes() {
 uint32 Kernel::getNumProcesses(ObjId objid, uint16 processtype) {
 	uint32 count = 0;
 
+	if (objid != 0) {
+		Std::map<ObjId, Std::vector<Process *> >::const_iterator procs = _itemProcesses.find(objid);
+		if (procs == _itemProcesses.end())
+			return 0;
+
+		const Std::vector<Process *> &list = procs->_value;
+		for (Std::vector<Process *>::const_iterator it = list.begin(); it != list.end(); ++it) {
+			const Process *p = *it;
+			if (!p->is_terminated() && (processtype == 6 || processtype == p->_type))
+				count++;
+		}
+		return count;
+	}
+
 	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
 		Process *p = *it;
 
@@ -271,6 +357,31 @@ uint32 Kernel::getNumProcesses(ObjId objid, uint16 processtype) {
 }
 
 Process *Kernel::findProcess(ObjId objid, uint16 processtype) {
+	if (objid != 0) {
+		Std::map<ObjId, Std::vector<Process *> >::const_iterator procs = _itemProcesses.find(objid);
+		if (procs == _itemProcesses.end())
+			return nullptr;
+
+		// The index isn't in run-list order (setNextProcess moves processes,
+		// setProcessItemNum appends them), so if several processes match, the
+		// run-list decides which one is found
+		Process *found = nullptr;
+		const Std::vector<Process *> &list = procs->_value;
+		for (Std::vector<Process *>::const_iterator it = list.begin(); it != list.end(); ++it) {
+			Process *p = *it;
+			if (!p->is_terminated() && (processtype == 6 || processtype == p->_type)) {
+				if (found)
+					return findProcessInRunList(objid, processtype);
+				found = p;
+			}
+		}
+		return found;
+	}
+
+	return findProcessInRunList(objid, processtype);
+}
+
+Process *Kernel::findProcessInRunList(ObjId objid, uint16 processtype) {
 	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
 		Process *p = *it;
 
@@ -350,6 +461,7 @@ bool Kernel::load(Common::ReadStream *rs, uint32 version) {
 		Process *p = loadProcess(rs, version);
 		if (!p) return false;
 		_processes.push_back(p);
+		indexProcess(p);
 	}
 
 	return true;
@@ -62,6 +62,9 @@ public:
 
 	ProcId assignPID(Process *proc);
 
+	//! change the item of a process, keeping the item index up to date
+	void setProcessItemNum(Process *proc, ObjId item);
+
 	void setNextProcess(Process *proc);
 	Process *getRunningProcess() const {
 		return _runningProcess;
@@ -130,9 +133,22 @@ public:
 private:
 	Process *loadProcess(Common::ReadStream *rs, uint32 version);
 
+	//! add/remove a process in the run-list to/from the lookup tables
+	void indexProcess(Process *proc);
+	void unindexProcess(Process *proc);
+
+	//! findProcess by walking the run-list, so the first match is returned
+	Process *findProcessInRunList(ObjId objid, uint16 processtype);
+
 	Std::list<Process *> _processes;
 	idMan   *_pIDs;
 
+	//! processes in the run-list, indexed by pid
+	Std::vector<Process *> _pidTable;
+
+	//! processes in the run-list which have an item, indexed by item
+	Std::map<ObjId, Std::vector<Process *> > _itemProcesses;
+
 	Std::list<Process *>::iterator current_process;
 
 	Std::map<Common::String, ProcessLoadFunc> _processLoaders;
@@ -145,6 +161,11 @@ private:
 
 	Process *_runningProcess;
 
+	// Scheduling statistics
+	uint32 _statFrames;
+	uint32 _statProcessesRun;
+	uint32 _statRunTime;
+
 	static Kernel *_kernel;
 };
 
@@ -30,11 +30,83 @@ namespace Ultima8 {
 // p_dynamic_cast stuff
 DEFINE_RUNTIME_CLASSTYPE_CODE(Process)
 
+// Freed processes are kept in free lists by size, and handed out again
+// to new processes of the same size
+static const uint POOL_GRANULARITY = 16;
+static const uint POOL_BUCKETS = 64;
+
+struct PooledProcess {
+	PooledProcess *_next;
+};
+
+static PooledProcess *processPool[POOL_BUCKETS];
+static uint32 poolAllocated = 0;
+static uint32 poolReused = 0;
+static uint32 poolFree = 0;
+
+void *Process::operator new(size_t size) {
+	const uint bucket = (size + POOL_GRANULARITY - 1) / POOL_GRANULARITY;
+	if (bucket >= POOL_BUCKETS)
+		return ::operator new(size);
+
+	PooledProcess *p = processPool[bucket];
+	if (p) {
+		processPool[bucket] = p->_next;
+		poolFree--;
+		poolReused++;
+		return p;
+	}
+
+	poolAllocated++;
+	return ::operator new(bucket * POOL_GRANULARITY);
+}
+
+void Process::operator delete(void *ptr, size_t size) {
+	if (!ptr)
+		return;
+
+	const uint bucket = (size + POOL_GRANULARITY - 1) / POOL_GRANULARITY;
+	if (bucket >= POOL_BUCKETS) {
+		::operator delete(ptr);
+		return;
+	}
+
+	PooledProcess *p = static_cast<PooledProcess *>(ptr);
+	p->_next = processPool[bucket];
+	processPool[bucket] = p;
+	poolFree++;
+}
+
+void Process::clearPool() {
+	for (uint i = 0; i < POOL_BUCKETS; i++) {
+		while (processPool[i]) {
+			PooledProcess *p = processPool[i];
+			processPool[i] = p->_next;
+			::operator delete(p);
+		}
+	}
+	poolAllocated -= poolFree;
+	poolFree = 0;
+}
+
+void Process::getPoolStats(uint32 &allocated, uint32 &reused, uint32 &pooled) {
+	allocated = poolAllocated;
+	reused = poolReused;
+	pooled = poolFree;
+}
+
 Process::Process(ObjId it, uint16 ty)
 	: _pid(0xFFFF), _flags(0), _itemNum(it), _type(ty), _result(0) {
 	Kernel::get_instance()->assignPID(this);
 }
 
+void Process::setItemNum(ObjId it) {
+	if (_flags & PROC_ACTIVE)
+		Kernel::get_instance()->setProcessItemNum(this, it);
+	else
+		_itemNum = it;
+}
+
 void Process::fail() {
 	assert(!(_flags & PROC_TERMINATED));
 
@@ -89,9 +89,9 @@ public:
 	//! A hook to add aditional behavior on wakeup, before anything else happens
 	virtual void onWakeUp() {};
 
-	void setItemNum(ObjId it) {
-		_itemNum = it;
-	}
+	//! set the item. The Kernel indexes processes by item, so this must
+	//! be used instead of assigning _itemNum once the process was added.
+	void setItemNum(ObjId it);
 	void setType(uint16 ty) {
 		_type = ty;
 	}
@@ -109,6 +109,17 @@ public:
 	//! dump some info about this process to pout
 	virtual void dumpInfo() const;
 
+	//! Processes are allocated from a pool, since many of them only
+	//! live for a few frames
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr, size_t size);
+
+	//! free the memory of pooled processes which are not in use
+	static void clearPool();
+
+	//! get statistics about the process pool
+	static void getPoolStats(uint32 &allocated, uint32 &reused, uint32 &pooled);
+
 	//! load Process data
 	bool loadData(Common::ReadStream *rs, uint32 version);
 
@@ -132,6 +132,7 @@ Debugger::Debugger() : Shared::Debugger() {
 	registerCmd("GameMapGump::dumpMap", WRAP_METHOD(Debugger, cmdDumpMap));
 	registerCmd("GameMapGump::incrementSortOrder", WRAP_METHOD(Debugger, cmdIncrementSortOrder));
 	registerCmd("GameMapGump::decrementSortOrder", WRAP_METHOD(Debugger, cmdDecrementSortOrder));
+	registerCmd("GameMapGump::benchmarkSortOrder", WRAP_METHOD(Debugger, cmdBenchmarkSortOrder));
 
 	registerCmd("Kernel::processTypes", WRAP_METHOD(Debugger, cmdProcessTypes));
 	registerCmd("Kernel::processInfo", WRAP_METHOD(Debugger, cmdProcessInfo));
@@ -911,6 +912,33 @@ bool Debugger::cmdDecrementSortOrder(int argc, const char **argv) {
 	return false;
 }
 
+bool Debugger::cmdBenchmarkSortOrder(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("usage: GameMapGump::benchmarkSortOrder [<iterations>]\n");
+		return true;
+	}
+
+	GameMapGump *gump = Ultima8Engine::get_instance()->getGameMapGump();
+	if (!gump) {
+		debugPrintf("No GameMapGump\n");
+		return true;
+	}
+
+	int iterations = 100;
+	if (argc == 2)
+		iterations = static_cast<int>(strtol(argv[1], 0, 0));
+	if (iterations < 1) {
+		debugPrintf("Iterations must be at least 1\n");
+		return true;
+	}
+
+	uint32 itemCount;
+	uint32 elapsed = gump->BenchmarkSortOrder(iterations, itemCount);
+	debugPrintf("Sorted %u items %d times in %u ms (%.3f ms per frame)\n",
+	            itemCount, iterations, elapsed, (double)elapsed / iterations);
+	return true;
+}
+
 
 bool Debugger::cmdProcessTypes(int argc, const char **argv) {
 	Kernel::get_instance()->processTypes();
@@ -82,7 +82,7 @@ void CrosshairProcess::run() {
 			Item *item = getItem(_itemNum);
 			assert(item);
 			item->destroy();
-			_itemNum = 0;
+			setItemNum(0);
 		}
 	}
 }
@@ -49,7 +49,7 @@ void DestroyItemProcess::run() {
 	if (_itemNum == 0) {
 		// need to get ObjId to use from process result. (We were apparently
 		// waiting for a process which returned the ObjId to delete.)
-		_itemNum = static_cast<ObjId>(_result);
+		setItemNum(static_cast<ObjId>(_result));
 	}
 
 	Item *it = getItem(_itemNum);
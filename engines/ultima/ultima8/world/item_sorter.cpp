@@ -30,6 +30,8 @@
 #include "ultima/ultima8/graphics/render_surface.h"
 #include "ultima/ultima8/misc/rect.h"
 #include "ultima/ultima8/games/game_data.h"
+#include "common/algorithm.h"
+#include "common/system.h"
 
 // temp
 #include "ultima/ultima8/world/actors/weapon_overlay.h"
@@ -50,7 +52,8 @@ struct SortItem {
 			_syTop(0), _sxBot(0), _syBot(0),_f32x32(false), _flat(false),
 			_occl(false), _solid(false), _draw(false), _roof(false),
 			_noisy(false), _anim(false), _trans(false), _fixed(false),
-			_land(false), _occluded(false), _clipped(0) { }
+			_land(false), _occluded(false), _clipped(0), _addIndex(0),
+			_lastCheck(0), _listRun(0) { }
 
 	SortItem                *_next;
 	SortItem                *_prev;
@@ -115,6 +118,10 @@ struct SortItem {
 
 	int32   _order;      // Rendering _order. -1 is not yet drawn
 
+	uint32  _addIndex;   // Position in which the item was added, starting at 1
+	uint32  _lastCheck;  // _addIndex of the last item compared against us
+	uint32  _listRun;    // Run of the sorted list we are in (see AddItem)
+
 	// Note that Std::priority_queue could be used here, BUT there is no guarentee that it's implementation
 	// will be friendly to insertions
 	// Alternatively i could use Std::list, BUT there is no guarentee that it will keep wont delete
@@ -238,6 +245,12 @@ struct SortItem {
 		return _z < other->_z || (_z == other->_z && _flat);
 	}
 
+	// Position in the sorted list among items of equal z. Flats are inserted
+	// before, and other items after, all items already added with the same z
+	inline int32 ListTieBreak() const {
+		return _flat ? -(int32)_addIndex : (int32)_addIndex;
+	}
+
 };
 
 // Check to see if we overlap si2
@@ -576,22 +589,46 @@ inline bool SortItem::operator<<(const SortItem &si2) const {
 }
 
 
+// Orders SortItems the same way the sorted list is built by ListLessThan
+struct SortItemListLess {
+	bool operator()(const SortItem *si1, const SortItem *si2) const {
+		if (si1->_listRun != si2->_listRun)
+			return si1->_listRun < si2->_listRun;
+		if (si1->_z != si2->_z)
+			return si1->_z < si2->_z;
+		return si1->ListTieBreak() < si2->ListTieBreak();
+	}
+};
+
+// The parameters an item was added to the display list with
+struct SortItemRecord {
+	int32 _x, _y, _z;
+	uint32 _shapeNum, _frame, _flags, _extFlags;
+	uint16 _itemNum;
+	uint32 _addIndex;
+
+	bool operator<(const SortItemRecord &other) const {
+		return _addIndex < other._addIndex;
+	}
+};
+
 //
 // ItemSorter
 //
 
 ItemSorter::ItemSorter() :
 	_shapes(nullptr), _surf(nullptr), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0) {
+	_itemsUnused(nullptr), _sortLimit(0), _camX(0), _camY(0), _camZ(0),
+	_camSx(0), _camSy(0), _orderCounter(0), _itemsLinked(true), _addCounter(0),
+	_bucketLeft(0), _bucketWidth(1) {
 	int i = 2048;
 	while (i--) _itemsUnused = new SortItem(_itemsUnused);
 }
 
 ItemSorter::~ItemSorter() {
-	//
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
+	for (uint i = 0; i < _addedItems.size(); i++) {
+		_addedItems[i]->_next = _itemsUnused;
+		_itemsUnused = _addedItems[i];
 	}
 	_items = nullptr;
 	_itemsTail = nullptr;
@@ -610,18 +647,38 @@ void ItemSorter::BeginDisplayList(RenderSurface *rs,
 	// Get the _shapes, if required
 	if (!_shapes) _shapes = GameData::get_instance()->getMainShapes();
 
-	//
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
+	// Recycle the SortItems. Array::resize keeps the storage around
+	for (uint i = 0; i < _addedItems.size(); i++) {
+		_addedItems[i]->_next = _itemsUnused;
+		_itemsUnused = _addedItems[i];
 	}
+	_addedItems.resize(0);
 	_items = nullptr;
 	_itemsTail = nullptr;
+	_itemsLinked = true;
+	_addCounter = 0;
+
+	for (int i = 0; i < NUM_SORT_BUCKETS; i++)
+		_buckets[i].resize(0);
+	_runLast.resize(0);
+	_runLast.push_back(nullptr);
 
 	// Set the RenderSurface, and reset the item list
 	_surf = rs;
 	_orderCounter = 0;
 
+	// Spread the buckets over the clipping window
+	Rect clip;
+	_surf->GetClippingRect(clip);
+	_bucketLeft = clip.left;
+	_bucketWidth = (clip.right - clip.left + NUM_SORT_BUCKETS - 1) / NUM_SORT_BUCKETS;
+	if (_bucketWidth < 1)
+		_bucketWidth = 1;
+
+	_camX = camx;
+	_camY = camy;
+	_camZ = camz;
+
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	_camSx = (camx - camy) / 4;
 	// Screenspace bounding box bottom extent  (RNB y coord)
@@ -712,14 +769,40 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	// Only items sharing a screenspace x bucket with us can overlap, so
+	// gather those instead of iterating the whole list. They are visited in
+	// list order, so the result is the same as comparing against every item.
+	si->_addIndex = ++_addCounter;
+	int firstBucket = GetBucket(MIN(si->_sxLeft, si->_sxRight));
+	int lastBucket = GetBucket(MAX(si->_sxLeft, si->_sxRight));
+
+	_candidates.resize(0);
+	for (int b = firstBucket; b <= lastBucket; b++) {
+		const Common::Array<SortItem *> &bucket = _buckets[b];
+		for (uint i = 0; i < bucket.size(); i++) {
+			SortItem *si2 = bucket[i];
+			if (si2->_lastCheck == si->_addIndex)
+				continue;
+			si2->_lastCheck = si->_addIndex;
+			_candidates.push_back(si2);
+		}
+	}
+	Common::sort(_candidates.begin(), _candidates.end(), SortItemListLess());
+
+	// Find the run holding the first item in list order we go before
+	uint insertRun = 0;
+	bool insertFound = false;
+	for (uint r = 0; r < _runLast.size(); r++) {
+		if (_runLast[r] && si->ListLessThan(_runLast[r])) {
+			insertRun = r;
+			insertFound = true;
+			break;
+		}
+	}
+	bool appended = false;
 
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->ListLessThan(si2))
-			addpoint = si2;
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si2 = _candidates[i];
 
 		// Doesn't overlap
 		if (si2->_occluded || !si->overlap(*si2))
@@ -731,6 +814,9 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 			if (si2->_occl && si2->occludes(*si)) {
 				// No need to do any more checks, this isn't visible
 				si->_occluded = true;
+				// If our place in the list is after si2, we go at the end
+				appended = !insertFound || insertRun > si2->_listRun ||
+				           (insertRun == si2->_listRun && !si->ListLessThan(si2));
 				break;
 			}
 
@@ -746,30 +832,54 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 		}
 	}
 
-	// Add it to the list
+	// Add it to the list. Items appended at the end start a new run, so
+	// later items keep going before or after them as in a linked list.
 	_itemsUnused = _itemsUnused->_next;
-
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
+	si->_lastCheck = 0;
+
+	if (appended) {
+		si->_listRun = _runLast.size();
+		_runLast.push_back(si);
+		_runLast.push_back(nullptr);
+	} else {
+		// A single appended item ends the run before it, so go there
+		si->_listRun = insertFound ? (insertRun & ~1) : _runLast.size() - 1;
+		SortItem *&last = _runLast[si->_listRun];
+		if (!last || SortItemListLess()(last, si))
+			last = si;
 	}
-	// Add it to the end of the list
-	else {
+
+	_addedItems.push_back(si);
+	_itemsLinked = false;
+	for (int b = firstBucket; b <= lastBucket; b++)
+		_buckets[b].push_back(si);
+}
+
+int ItemSorter::GetBucket(int32 sx) const {
+	int bucket = (sx - _bucketLeft) / _bucketWidth;
+	return CLIP<int>(bucket, 0, NUM_SORT_BUCKETS - 1);
+}
+
+void ItemSorter::LinkDisplayList() {
+	if (_itemsLinked)
+		return;
+
+	Common::sort(_addedItems.begin(), _addedItems.end(), SortItemListLess());
+
+	_items = nullptr;
+	_itemsTail = nullptr;
+	for (uint i = 0; i < _addedItems.size(); i++) {
+		SortItem *si = _addedItems[i];
+		si->_prev = _itemsTail;
+		si->_next = nullptr;
 		if (_itemsTail)
 			_itemsTail->_next = si;
-		if (!_items)
+		else
 			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
 		_itemsTail = si;
 	}
+
+	_itemsLinked = true;
 }
 
 void ItemSorter::AddItem(const Item *add) {
@@ -779,9 +889,49 @@ void ItemSorter::AddItem(const Item *add) {
 			add->getFlags(), add->getExtFlags(), add->getObjId());
 }
 
+uint32 ItemSorter::BenchmarkDisplayList(int iterations, uint32 &itemCount) {
+	itemCount = 0;
+	if (!_surf)
+		return 0;
+
+	// Record what went into the current display list
+	Common::Array<SortItemRecord> records;
+	for (uint i = 0; i < _addedItems.size(); i++) {
+		const SortItem *si = _addedItems[i];
+		SortItemRecord record;
+		record._x = si->_x;
+		record._y = si->_y;
+		record._z = si->_z;
+		record._shapeNum = si->_shapeNum;
+		record._frame = si->_frame;
+		record._flags = si->_flags;
+		record._extFlags = si->_extFlags;
+		record._itemNum = si->_itemNum;
+		record._addIndex = si->_addIndex;
+		records.push_back(record);
+	}
+	itemCount = records.size();
+
+	// Add them back in their original order
+	Common::sort(records.begin(), records.end());
+
+	uint32 startTime = g_system->getMillis();
+	for (int i = 0; i < iterations; i++) {
+		BeginDisplayList(_surf, _camX, _camY, _camZ);
+		for (uint j = 0; j < records.size(); j++) {
+			const SortItemRecord &r = records[j];
+			AddItem(r._x, r._y, r._z, r._shapeNum, r._frame, r._flags, r._extFlags, r._itemNum);
+		}
+		LinkDisplayList();
+	}
+	return g_system->getMillis() - startTime;
+}
+
 SortItem *_prev = 0;
 
 void ItemSorter::PaintDisplayList(bool item_highlight) {
+	LinkDisplayList();
+
 	_prev = nullptr;
 	SortItem *it = _items;
 	SortItem *end = nullptr;
@@ -929,6 +1079,8 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	LinkDisplayList();
+
 	if (!_orderCounter) { // If no _orderCounter we need to sort the _items
 		it = _items;
 		_orderCounter = 0;  // Reset the _orderCounter
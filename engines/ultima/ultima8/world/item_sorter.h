@@ -23,6 +23,8 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -42,8 +44,24 @@ class ItemSorter {
 
 	int32       _orderCounter;
 
+	int32       _camX, _camY, _camZ;
 	int32       _camSx, _camSy;
 
+	// All _items added since BeginDisplayList. The linked list (_items,
+	// _itemsTail) is only built from this when it is needed.
+	Common::Array<SortItem *> _addedItems;
+	bool        _itemsLinked;
+	uint32      _addCounter;
+
+	// Screenspace x buckets, used to only compare _items that can overlap
+	static const int NUM_SORT_BUCKETS = 32;
+	Common::Array<SortItem *> _buckets[NUM_SORT_BUCKETS];
+	Common::Array<SortItem *> _candidates;
+	// Last item of each sorted run of the list. Even runs are sorted by
+	// z, odd runs are single occluded items that were appended at the end
+	Common::Array<SortItem *> _runLast;
+	int32       _bucketLeft, _bucketWidth;
+
 public:
 	ItemSorter();
 	~ItemSorter();
@@ -65,6 +83,10 @@ public:
 	// If face is non-NULL, also return the face of the 3d bbox (x,y) is on
 	uint16 Trace(int32 x, int32 y, HitFace *face = 0, bool item_highlight = false);
 
+	// Re-sort the current display list a number of times.
+	// Returns the elapsed time in milliseconds
+	uint32 BenchmarkDisplayList(int iterations, uint32 &itemCount);
+
 	void IncSortLimit() {
 		_sortLimit++;
 	}
@@ -73,6 +95,8 @@ public:
 	}
 
 private:
+	void LinkDisplayList();
+	int GetBucket(int32 sx) const;
 	bool PaintSortItem(SortItem *);
 	bool NullPaintSortItem(SortItem *);
 };
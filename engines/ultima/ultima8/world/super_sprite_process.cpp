@@ -332,7 +332,7 @@ void SuperSpriteProcess::destroyItemOrTerminate() {
 		Item *item = getItem(_itemNum);
 		if (item)
 			item->destroy();
-		_itemNum = 0;
+		setItemNum(0);
 	} else {
 		terminate();
 	}
@@ -478,6 +478,24 @@ public:
 	 */
 	virtual void drawStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Applies the colors and settings of the specified draw step without
+	 * drawing anything. This leaves the renderer in the same state as
+	 * drawStep() does.
+	 */
+	void applyStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
+
+	enum {
+		kColorCount = 5 ///< Number of colors returned by getColors()
+	};
+
+	/**
+	 * Returns the active foreground, background, bevel, gradient start and
+	 * gradient end colors, in the format of the drawing surface.
+	 * Draw steps which don't set a color use the one left by previous steps.
+	 */
+	virtual void getColors(uint32 *colors) const = 0;
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
@@ -427,14 +427,10 @@ namespace Graphics {
 /**
  * Fills several pixels in a row with a given color.
  *
- * This is a replacement function for Common::fill, using an unrolled
- * loop to maximize performance on most architectures.
- * This function may (and should) be overloaded in any child renderers
- * for portable platforms with platform-specific assembly code.
- *
  * This fill operation is extensively used throughout the renderer, so this
- * counts as one of the main bottlenecks. Please replace it with assembly
- * when possible!
+ * counts as one of the main bottlenecks. It is deliberately kept as a plain
+ * loop: compilers turn it into wide vector stores on every architecture,
+ * which an unrolled loop written by hand prevents.
  *
  * @param first Pointer to the first pixel to fill.
  * @param last Pointer to the last pixel to fill.
@@ -442,23 +438,8 @@ namespace Graphics {
  */
 template<typename PixelType>
 void colorFill(PixelType *first, PixelType *last, PixelType color) {
-	int count = (last - first);
-	if (!count)
-		return;
-	int n = (count + 7) >> 3;
-	switch (count % 8) {
-	default:
-	case 0:	do {
-	       		*first++ = color; // fall through
-	case 7:		*first++ = color; // fall through
-	case 6:		*first++ = color; // fall through
-	case 5:		*first++ = color; // fall through
-	case 4:		*first++ = color; // fall through
-	case 3:		*first++ = color; // fall through
-	case 2:		*first++ = color; // fall through
-	case 1:		*first++ = color;
-	       	} while (--n > 0);
-	}
+	while (first < last)
+		*first++ = color;
 }
 
 template<typename PixelType>
@@ -466,40 +447,12 @@ void colorFillClip(PixelType *first, PixelType *last, PixelType color, int realX
 	if (realY < clippingArea.top || realY >= clippingArea.bottom)
 		return;
 
-	int count = (last - first);
+	// Clip the span once instead of testing every pixel
+	const int left = MAX<int>(clippingArea.left - realX, 0);
+	const int right = MIN<int>(clippingArea.right - realX, last - first);
 
-	if (realX > clippingArea.right || realX + count < clippingArea.left)
-		return;
-
-	if (realX < clippingArea.left) {
-		int diff = (clippingArea.left - realX);
-		realX += diff;
-		first += diff;
-		count -= diff;
-	}
-
-	if (clippingArea.right <= realX + count) {
-		int diff = (realX + count - clippingArea.right);
-		count -= diff;
-	}
-
-	if (!count)
-		return;
-
-	int n = (count + 7) >> 3;
-	switch (count % 8) {
-	default:
-	case 0:	do {
-	       		*first++ = color; // fall through
-	case 7:		*first++ = color; // fall through
-	case 6:		*first++ = color; // fall through
-	case 5:		*first++ = color; // fall through
-	case 4:		*first++ = color; // fall through
-	case 3:		*first++ = color; // fall through
-	case 2:		*first++ = color; // fall through
-	case 1:		*first++ = color;
-	       	} while (--n > 0);
-	}
+	if (left < right)
+		colorFill<PixelType>(first + left, first + right, color);
 }
 
 
@@ -551,6 +504,16 @@ VectorRendererSpec(PixelFormat format) :
  * Gradient-related methods *
  ****************************/
 
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+getColors(uint32 *colors) const {
+	colors[0] = _fgColor;
+	colors[1] = _bgColor;
+	colors[2] = _bevelColor;
+	colors[3] = _gradientStart;
+	colors[4] = _gradientEnd;
+}
+
 template<typename PixelType>
 void VectorRendererSpec<PixelType>::
 setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) {
@@ -608,12 +571,18 @@ precalcGradient(int h) {
 
 template<typename PixelType>
 void VectorRendererSpec<PixelType>::
-gradientFill(PixelType *ptr, int width, int x, int y) {
+gradientRowColors(int y, PixelType &evenColor, PixelType &oddColor) {
 	bool ox = ((y & 1) == 1);
-	int curGrad = 0;
 
-	while (_gradIndexes[curGrad + 1] <= y)
-		curGrad++;
+	// Binary search for the strip containing y
+	int curGrad = 0, last = _gradIndexes.size() - 1;
+	while (curGrad + 1 < last) {
+		int mid = (curGrad + last) / 2;
+		if (_gradIndexes[mid] <= y)
+			curGrad = mid;
+		else
+			last = mid;
+	}
 
 	// precalcGradient assures that _gradIndexes entries always differ in
 	// their value. This assures stripSize is always different from zero.
@@ -630,20 +599,24 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	if (grad == 0 ||
 		_gradCache[curGrad] == _gradCache[curGrad + 1] || // no color change
 		stripSize < 2) { // the stip is small
-		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad]);
-	} else if (grad == 3 && ox) {
-		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
+		evenColor = oddColor = _gradCache[curGrad];
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
+		evenColor = ((grad == 2 || grad == 3) && ox) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
+		oddColor = (ox || grad == 3) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
+	}
+}
 
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+gradientFill(PixelType *ptr, int width, int x, int y) {
+	PixelType colors[2];
+	gradientRowColors(y, colors[0], colors[1]);
+
+	if (colors[0] == colors[1]) {
+		colorFill<PixelType>(ptr, ptr + width, colors[0]);
+	} else {
+		for (int j = x; j < x + width; j++)
+			*ptr++ = colors[j & 1];
 	}
 }
 
@@ -651,43 +624,13 @@ template<typename PixelType>
 void VectorRendererSpec<PixelType>::
 gradientFillClip(PixelType *ptr, int width, int x, int y, int realX, int realY) {
 	if (realY < _clippingArea.top || realY >= _clippingArea.bottom) return;
-	bool ox = ((y & 1) == 1);
-	int curGrad = 0;
-
-	while (_gradIndexes[curGrad + 1] <= y)
-		curGrad++;
 
-	// precalcGradient assures that _gradIndexes entries always differ in
-	// their value. This assures stripSize is always different from zero.
-	int stripSize = _gradIndexes[curGrad + 1] - _gradIndexes[curGrad];
-
-	int grad = (((y - _gradIndexes[curGrad]) % stripSize) << 2) / stripSize;
+	const int left = MAX<int>(_clippingArea.left - realX, 0);
+	const int right = MIN<int>(_clippingArea.right - realX, width);
+	if (left >= right)
+		return;
 
-	// Dithering:
-	//   +--+ +--+ +--+ +--+
-	//   |  | |  | | *| | *|
-	//   |  | | *| |* | |**|
-	//   +--+ +--+ +--+ +--+
-	//     0    1    2    3
-	if (grad == 0 ||
-		_gradCache[curGrad] == _gradCache[curGrad + 1] || // no color change
-		stripSize < 2) { // the stip is small
-		colorFillClip<PixelType>(ptr, ptr + width, _gradCache[curGrad], realX, realY, _clippingArea);
-	} else if (grad == 3 && ox) {
-		colorFillClip<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1], realX, realY, _clippingArea);
-	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			if (realX + j - x < _clippingArea.left || realX + j - x >= _clippingArea.right) continue;
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
-	}
+	gradientFill(ptr + left, right - left, x + left, y);
 }
 
 template<typename PixelType>
@@ -960,45 +903,86 @@ blendPixelDestAlphaPtr(PixelType *ptr, PixelType color, uint8 alpha) {
 }
 
 template<typename PixelType>
-inline void VectorRendererSpec<PixelType>::
-darkenFill(PixelType *ptr, PixelType *end) {
-	PixelType mask = (PixelType)((3 << _format.rShift) | (3 << _format.gShift) | (3 << _format.bShift));
+void VectorRendererSpec<PixelType>::
+blendFill(PixelType *ptr, PixelType *end, PixelType color, uint8 alpha) {
+	if (alpha == 0xff) {
+		// fully opaque span, don't blend
+		colorFill<PixelType>(ptr, end, color | _alphaMask);
+		return;
+	}
 
-	if (!g_system->hasFeature(OSystem::kFeatureOverlaySupportsAlpha)) {
-		// !kFeatureOverlaySupportsAlpha (but might have alpha bits)
+	// Same math as blendPixelPtr, with everything that is constant along the
+	// span kept in locals so that the compiler is free to vectorize the loop.
+	const PixelType rMask = _redMask, gMask = _greenMask, bMask = _blueMask, aMask = _alphaMask;
 
-		while (ptr != end) {
-			*ptr = ((*ptr & ~mask) >> 2) | _alphaMask;
-			++ptr;
+	if (sizeof(PixelType) == 4) {
+		const uint rShift = _format.rShift, gShift = _format.gShift, bShift = _format.bShift, aShift = _format.aShift;
+
+		const byte sR = (color & rMask) >> rShift;
+		const byte sG = (color & gMask) >> gShift;
+		const byte sB = (color & bMask) >> bShift;
+
+		while (ptr < end) {
+			const PixelType d = *ptr;
+
+			byte dR = (d & rMask) >> rShift;
+			byte dG = (d & gMask) >> gShift;
+			byte dB = (d & bMask) >> bShift;
+			byte dA = (d & aMask) >> aShift;
+
+			dR += ((sR - dR) * alpha) >> 8;
+			dG += ((sG - dG) * alpha) >> 8;
+			dB += ((sB - dB) * alpha) >> 8;
+			dA += ((0xff - dA) * alpha) >> 8;
+
+			*ptr++ = ((dR << rShift) & rMask)
+			       | ((dG << gShift) & gMask)
+			       | ((dB << bShift) & bMask)
+			       | ((dA << aShift) & aMask);
 		}
-	} else {
-		// kFeatureOverlaySupportsAlpha
-		// assuming at least 3 alpha bits
+	} else if (sizeof(PixelType) == 2) {
+		const int sR = color & rMask;
+		const int sG = color & gMask;
+		const int sB = color & bMask;
 
-		mask |= 3 << _format.aShift;
-		PixelType addA = (PixelType)(3 << (_format.aShift + 6 - _format.aLoss));
+		while (ptr < end) {
+			const int d = *ptr;
 
-		while (ptr != end) {
-			// Darken the color, and increase the alpha
-			// (0% -> 75%, 100% -> 100%)
-			*ptr = (PixelType)(((*ptr & ~mask) >> 2) + addA);
-			++ptr;
+			*ptr++ = (PixelType)(
+				(rMask & ((d & rMask) + ((int)((sR - (int)(d & rMask)) * alpha) >> 8))) |
+				(gMask & ((d & gMask) + ((int)((sG - (int)(d & gMask)) * alpha) >> 8))) |
+				(bMask & ((d & bMask) + ((int)((sB - (int)(d & bMask)) * alpha) >> 8))) |
+				(aMask & ((d & aMask) + ((int)(((int)aMask - (int)(d & aMask)) * alpha) >> 8))));
 		}
+	} else {
+		error("Unsupported BPP format: %u", (uint)sizeof(PixelType));
 	}
 }
 
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+blendFillClip(PixelType *ptr, PixelType *end, PixelType color, uint8 alpha, int realX, int realY) {
+	if (realY < _clippingArea.top || realY >= _clippingArea.bottom)
+		return;
+
+	const int left = MAX<int>(_clippingArea.left - realX, 0);
+	const int right = MIN<int>(_clippingArea.right - realX, end - ptr);
+
+	if (left < right)
+		blendFill(ptr + left, ptr + right, color, alpha);
+}
+
 template<typename PixelType>
 inline void VectorRendererSpec<PixelType>::
-darkenFillClip(PixelType *ptr, PixelType *end, int x, int y) {
+darkenFill(PixelType *ptr, PixelType *end) {
 	PixelType mask = (PixelType)((3 << _format.rShift) | (3 << _format.gShift) | (3 << _format.bShift));
 
 	if (!g_system->hasFeature(OSystem::kFeatureOverlaySupportsAlpha)) {
 		// !kFeatureOverlaySupportsAlpha (but might have alpha bits)
 
 		while (ptr != end) {
-			if (IS_IN_CLIP(x, y)) *ptr = ((*ptr & ~mask) >> 2) | _alphaMask;
+			*ptr = ((*ptr & ~mask) >> 2) | _alphaMask;
 			++ptr;
-			++x;
 		}
 	} else {
 		// kFeatureOverlaySupportsAlpha
@@ -1010,13 +994,25 @@ darkenFillClip(PixelType *ptr, PixelType *end, int x, int y) {
 		while (ptr != end) {
 			// Darken the color, and increase the alpha
 			// (0% -> 75%, 100% -> 100%)
-			if (IS_IN_CLIP(x, y)) *ptr = (PixelType)(((*ptr & ~mask) >> 2) + addA);
+			*ptr = (PixelType)(((*ptr & ~mask) >> 2) + addA);
 			++ptr;
-			++x;
 		}
 	}
 }
 
+template<typename PixelType>
+inline void VectorRendererSpec<PixelType>::
+darkenFillClip(PixelType *ptr, PixelType *end, int x, int y) {
+	if (y < _clippingArea.top || y >= _clippingArea.bottom)
+		return;
+
+	const int left = MAX<int>(_clippingArea.left - x, 0);
+	const int right = MIN<int>(_clippingArea.right - x, end - ptr);
+
+	if (left < right)
+		darkenFill(ptr + left, ptr + right);
+}
+
 /********************************************************************
  ********************************************************************
  * Primitive shapes drawing - Public API calls - VectorRendererSpec *
@@ -3162,9 +3158,7 @@ drawSquareShadow(int x, int y, int w, int h, int offset) {
 	ptr = (PixelType *)_activeSurface->getBasePtr(x + offset, y + h - 1);
 
 	while (i++ < offset) {
-		j = w - offset;
-		while (j--)
-			blendPixelPtr(ptr + j, 0, ((offset - i) << 8) / offset);
+		blendFill(ptr, ptr + w - offset, 0, ((offset - i) << 8) / offset);
 		ptr += pitch;
 	}
 
@@ -3206,9 +3200,7 @@ drawSquareShadowClip(int x, int y, int w, int h, int offset) {
 	ptr_y = y + h - 1;
 
 	while (i++ < offset) {
-		j = w - offset;
-		while (j--)
-			blendPixelPtrClip(ptr + j, 0, ((offset - i) << 8) / offset, ptr_x + j, ptr_y);
+		blendFillClip(ptr, ptr + w - offset, 0, ((offset - i) << 8) / offset, ptr_x, ptr_y);
 		ptr += pitch;
 		++ptr_y;
 	}
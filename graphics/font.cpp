@@ -149,6 +149,12 @@ struct WordWrapper {
 	}
 };
 
+template<class StringType>
+struct MeasuredChar {
+	typename StringType::unsigned_type c;
+	int width; // Character width plus the kerning offset to the previous character
+};
+
 template<class StringType>
 int wordWrapTextImpl(const Font &font, const StringType &str, int maxWidth, Common::Array<StringType> &lines, int initWidth, bool evenWidthLinesModeEnabled, bool wrapOnExplicitNewLines) {
 	WordWrapper<StringType> wrapper(lines);
@@ -171,40 +177,52 @@ int wordWrapTextImpl(const Font &font, const StringType &str, int maxWidth, Comm
 	// of a line. If we encounter such a word, we have to wrap it over multiple
 	// lines.
 
+	// Measure the text once up front. Even Width Lines mode lays the text out
+	// several times, and looking up glyph widths and kerning pairs is not
+	// free for TrueType fonts.
+	Common::Array<MeasuredChar<StringType> > measured;
+	measured.reserve(str.size());
+
 	typename StringType::unsigned_type last = 0;
+	bool hasExplicitNewLines = false;
+
+	for (typename StringType::const_iterator x = str.begin(); x != str.end(); ++x) {
+		typename StringType::unsigned_type c = *x;
+
+		// Convert Windows and Mac line breaks into plain \n
+		if (c == '\r') {
+			if (x != str.end() && *(x + 1) == '\n') {
+				++x;
+			}
+			c = '\n';
+		}
+		// if wrapping on explicit new lines is disabled, then new line characters should be treated as a single white space char
+		if (c == '\n') {
+			if (!wrapOnExplicitNewLines) {
+				c = ' ';
+			} else {
+				hasExplicitNewLines = true;
+			}
+		}
+
+		MeasuredChar<StringType> m;
+		m.c = c;
+		m.width = font.getCharWidth(c) + font.getKerningOffset(last, c);
+		measured.push_back(m);
+		last = c;
+	}
 
-	// When EvenWidthLines mode is enabled then we require an early loop over the entire string
-	// in order to get the full width of the text
+	// When EvenWidthLines mode is enabled then we require the full width of the text
 	//
 	// "Wrap On Explicit New Lines" and "Even Width Lines" modes are mutually exclusive,
 	// If both are set to true and there are new line characters in the text,
 	// then "Even Width Lines" mode is disabled.
 	//
-	if (evenWidthLinesModeEnabled) {
-		// Early loop to get the full width of the text
-		for (typename StringType::const_iterator x = str.begin(); x != str.end(); ++x) {
-			typename StringType::unsigned_type c = *x;
-
-			// Check for Windows and Mac line breaks
-			if (c == '\r') {
-				if (x != str.end() && *(x + 1) == '\n') {
-					++x;
-				}
-				c = '\n';
-			}
-
-			if (c == '\n') {
-				if (!wrapOnExplicitNewLines) {
-					c = ' ';
-				} else {
-					evenWidthLinesModeEnabled = false;
-					break;
-				}
-			}
-
-			const int w = font.getCharWidth(c) + font.getKerningOffset(last, c);
-			last = c;
-			fullTextWidthEWL += w;
+	if (hasExplicitNewLines) {
+		evenWidthLinesModeEnabled = false;
+	} else if (evenWidthLinesModeEnabled) {
+		for (uint i = 0; i < measured.size(); ++i) {
+			fullTextWidthEWL += measured[i].width;
 		}
 	}
 
@@ -226,27 +244,11 @@ int wordWrapTextImpl(const Font &font, const StringType &str, int maxWidth, Comm
 			targetMaxLineWidth = maxWidth;
 		}
 
-		last = 0;
 		tmpWidth = 0;
 
-		for (typename StringType::const_iterator x = str.begin(); x != str.end(); ++x) {
-			typename StringType::unsigned_type c = *x;
-
-			// Convert Windows and Mac line breaks into plain \n
-			if (c == '\r') {
-				if (x != str.end() && *(x + 1) == '\n') {
-					++x;
-				}
-				c = '\n';
-			}
-			// if wrapping on explicit new lines is disabled, then new line characters should be treated as a single white space char
-			if (!wrapOnExplicitNewLines && c == '\n')  {
-				c = ' ';
-			}
-
-			const int currentCharWidth = font.getCharWidth(c);
-			const int w = currentCharWidth + font.getKerningOffset(last, c);
-			last = c;
+		for (uint i = 0; i < measured.size(); ++i) {
+			const typename StringType::unsigned_type c = measured[i].c;
+			const int w = measured[i].width;
 			const bool wouldExceedWidth = (lineWidth + tmpWidth + w > targetMaxLineWidth);
 
 			// If this char is a whitespace, then it represents a potential
@@ -288,7 +290,7 @@ int wordWrapTextImpl(const Font &font, const StringType &str, int maxWidth, Comm
 						// If tmpStr is empty, we might have removed the space before 'c'.
 						// That means we have to recompute the kerning.
 
-						tmpWidth += currentCharWidth + font.getKerningOffset(0, c);
+						tmpWidth += font.getCharWidth(c) + font.getKerningOffset(0, c);
 						tmpStr += c;
 						continue;
 					}
@@ -37,6 +37,7 @@
 #include "common/singleton.h"
 #include "common/stream.h"
 #include "common/memstream.h"
+#include "common/array.h"
 #include "common/hashmap.h"
 #include "common/ptr.h"
 #include "common/unzip.h"
@@ -164,6 +165,8 @@ private:
 	int _ascent, _descent;
 
 	struct Glyph {
+		Glyph() : xOffset(0), yOffset(0), advance(0), slot(0) {}
+
 		Surface image;
 		int xOffset, yOffset;
 		int advance;
@@ -173,9 +176,27 @@ private:
 	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
-	bool _allowLateCaching;
+	Common::Array<uint32> _mapping;
 	void assureCached(uint32 chr) const;
 
+	/**
+	 * Glyph images are rasterized on first use and packed row by row into
+	 * shared 8bpp atlas pages, so that loading a font does not allocate a
+	 * surface for every glyph. The glyph surfaces point into these pages.
+	 */
+	enum {
+		kAtlasPageSize = 256
+	};
+
+	mutable Common::Array<Surface *> _atlasPages;
+	mutable Surface *_atlasPage;
+	mutable int _atlasX, _atlasY, _atlasRowHeight;
+	void allocateGlyphImage(Surface &image, int w, int h) const;
+
+	typedef Common::HashMap<uint32, int> KerningCache;
+	mutable KerningCache _kerningPairs;
+	int computeKerningOffset(uint32 left, uint32 right) const;
+
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
 	int computePointSize(int size, TTFSizeMode sizeMode) const;
@@ -192,8 +213,9 @@ private:
 
 TTFFont::TTFFont()
     : _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-      _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
-      _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false) {
+      _descent(0), _glyphs(), _atlasPage(nullptr), _atlasX(0), _atlasY(0), _atlasRowHeight(0),
+      _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
+      _hasKerning(false), _fakeBold(false), _fakeItalic(false) {
 }
 
 TTFFont::~TTFFont() {
@@ -203,11 +225,13 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
+
+	for (uint i = 0; i < _atlasPages.size(); ++i) {
+		_atlasPages[i]->free();
+		delete _atlasPages[i];
+	}
 }
 
 bool TTFFont::load(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode,
@@ -334,28 +358,27 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 		_loadFlags |= FT_LOAD_NO_BITMAP;
 	}
 
+	// Glyphs are rendered when they are first used. At this point we only
+	// check that the font provides any of the characters we are going to ask
+	// for, and render the glyphs a fixed mapping marks as required.
+	bool hasGlyphs = false;
+
 	if (!mapping) {
 		// Allow loading of all unicode characters.
-		_allowLateCaching = true;
-
-		// Load all ISO-8859-1 characters.
-		for (uint i = 0; i < 256; ++i) {
-			if (!cacheGlyph(_glyphs[i], i)) {
-				_glyphs.erase(i);
-			}
+		for (uint i = 0; i < 256 && !hasGlyphs; ++i) {
+			hasGlyphs = (FT_Get_Char_Index(_face, i) != 0);
 		}
 	} else {
 		// We have a fixed map of characters do not load more later.
-		_allowLateCaching = false;
+		_mapping.resize(256);
 
 		for (uint i = 0; i < 256; ++i) {
-			const uint32 unicode = mapping[i] & 0x7FFFFFFF;
+			_mapping[i] = mapping[i] & 0x7FFFFFFF;
 			const bool isRequired = (mapping[i] & 0x80000000) != 0;
 			// Check whether loading an important glyph fails and error out if
 			// that is the case.
-			if (!cacheGlyph(_glyphs[i], unicode)) {
-				_glyphs.erase(i);
-				if (isRequired) {
+			if (isRequired) {
+				if (!cacheGlyph(_glyphs[i], _mapping[i])) {
 					g_ttf.closeFont(_face);
 
 					// Don't delete ttfFile as we return fail
@@ -364,10 +387,14 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 					return false;
 				}
 			}
+
+			if (!hasGlyphs) {
+				hasGlyphs = (FT_Get_Char_Index(_face, _mapping[i]) != 0);
+			}
 		}
 	}
 
-	if (_glyphs.size() == 0) {
+	if (!hasGlyphs) {
 		g_ttf.closeFont(_face);
 
 		// Don't delete ttfFile as we return fail
@@ -524,6 +551,22 @@ int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!_hasKerning)
 		return 0;
 
+	// Text layout asks for the same few pairs over and over again, so
+	// remember what FreeType told us for pairs of BMP characters.
+	if (left > 0xFFFF || right > 0xFFFF)
+		return computeKerningOffset(left, right);
+
+	const uint32 pair = (left << 16) | right;
+	KerningCache::const_iterator kerningEntry = _kerningPairs.find(pair);
+	if (kerningEntry != _kerningPairs.end())
+		return kerningEntry->_value;
+
+	const int offset = computeKerningOffset(left, right);
+	_kerningPairs[pair] = offset;
+	return offset;
+}
+
+int TTFFont::computeKerningOffset(uint32 left, uint32 right) const {
 	assureCached(left);
 	assureCached(right);
 
@@ -741,7 +784,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	allocateGlyphImage(glyph.image, bitmap->width, bitmap->rows);
 
 	const uint8 *src = bitmap->buffer;
 	int srcPitch = bitmap->pitch;
@@ -750,8 +793,8 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		srcPitch = -srcPitch;
 	}
 
+	// Atlas pages start out cleared and their areas are never reused
 	uint8 *dst = (uint8 *)glyph.image.getPixels();
-	memset(dst, 0, glyph.image.h * glyph.image.pitch);
 
 	switch (bitmap->pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
@@ -764,12 +807,12 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					dst[x] = 255;
 
 				mask <<= 1;
-				++dst;
 			}
 
+			dst += glyph.image.pitch;
 			src += srcPitch;
 		}
 		break;
@@ -784,7 +827,6 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 
 	default:
 		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
 		return false;
 	}
 
@@ -798,14 +840,57 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 }
 
 void TTFFont::assureCached(uint32 chr) const {
-	if (!chr || !_allowLateCaching || _glyphs.contains(chr)) {
+	if (_glyphs.contains(chr)) {
 		return;
 	}
 
+	uint32 unicode = chr;
+	if (!_mapping.empty()) {
+		if (chr >= _mapping.size())
+			return;
+		unicode = _mapping[chr];
+	}
+
+	// Characters the font can't render are remembered as empty glyphs, so
+	// that we don't ask FreeType about them again.
 	Glyph newGlyph;
-	if (cacheGlyph(newGlyph, chr)) {
-		_glyphs[chr] = newGlyph;
+	if (!cacheGlyph(newGlyph, unicode)) {
+		newGlyph = Glyph();
+	}
+	_glyphs[chr] = newGlyph;
+}
+
+void TTFFont::allocateGlyphImage(Surface &image, int w, int h) const {
+	if (w <= 0 || h <= 0) {
+		image = Surface();
+		return;
 	}
+
+	if (w > kAtlasPageSize || h > kAtlasPageSize) {
+		// Huge glyphs get a page of their own
+		Surface *page = new Surface();
+		page->create(w, h, PixelFormat::createFormatCLUT8());
+		_atlasPages.push_back(page);
+		image = *page;
+		return;
+	}
+
+	if (_atlasX + w > kAtlasPageSize) {
+		_atlasX = 0;
+		_atlasY += _atlasRowHeight;
+		_atlasRowHeight = 0;
+	}
+
+	if (!_atlasPage || _atlasY + h > kAtlasPageSize) {
+		_atlasPage = new Surface();
+		_atlasPage->create(kAtlasPageSize, kAtlasPageSize, PixelFormat::createFormatCLUT8());
+		_atlasPages.push_back(_atlasPage);
+		_atlasX = _atlasY = _atlasRowHeight = 0;
+	}
+
+	image = _atlasPage->getSubArea(Common::Rect(_atlasX, _atlasY, _atlasX + w, _atlasY + h));
+	_atlasX += w;
+	_atlasRowHeight = MAX(_atlasRowHeight, h);
 }
 
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode, uint dpi, TTFRenderMode renderMode, const uint32 *mapping) {
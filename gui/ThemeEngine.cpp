@@ -96,8 +96,177 @@ struct WidgetDrawData {
 	 * value will be added when restoring the background of the widget.
 	 */
 	void calcBackgroundOffset();
+
+	/** Whether the draw steps stay within the area used for dirty rects */
+	bool _cacheable;
+
+	/** Whether the first draw step leaves some of the renderer colors unset */
+	bool _inheritsColors;
+
+	/**
+	 * Checks whether the results of drawing this DrawData can be cached.
+	 * Steps with explicit sizes, bitmaps and tabs may draw outside of the
+	 * widget area, and steps may use the colors left over in the renderer
+	 * by whatever was drawn before.
+	 */
+	void calcCacheability();
+};
+
+/**
+ * Rasterized DrawData items, so that redrawing a widget which looks the same
+ * as before is a copy instead of replaying all its draw steps.
+ *
+ * Draw steps blend with what is already on the surface, so an entry stores
+ * the pixels of the area before and after drawing, and is only used when the
+ * pixels before drawing match again.
+ */
+struct DrawDataCacheKey {
+	DrawData type;
+	uint32 dynamic;
+	const Graphics::Surface *surface;
+	Common::Rect area;
+	Common::Rect clip;
+	uint32 colors[Graphics::VectorRenderer::kColorCount];
+
+	bool operator==(const DrawDataCacheKey &other) const {
+		return type == other.type && dynamic == other.dynamic && surface == other.surface &&
+		       area == other.area && clip == other.clip &&
+		       !memcmp(colors, other.colors, sizeof(colors));
+	}
+};
+
+struct DrawDataCacheKey_Hash {
+	uint operator()(const DrawDataCacheKey &key) const {
+		uint hash = key.type * 31 + key.dynamic;
+		hash = hash * 31 + ((uint16)key.area.left << 16) + (uint16)key.area.top;
+		hash = hash * 31 + ((uint16)key.area.right << 16) + (uint16)key.area.bottom;
+		hash = hash * 31 + ((uint16)key.clip.left << 16) + (uint16)key.clip.top;
+		hash = hash * 31 + ((uint16)key.clip.right << 16) + (uint16)key.clip.bottom;
+		for (int i = 0; i < Graphics::VectorRenderer::kColorCount; ++i)
+			hash = hash * 31 + key.colors[i];
+		return hash;
+	}
+};
+
+struct DrawDataCacheEntry {
+	Common::Rect rect;
+	Graphics::Surface before;
+	Graphics::Surface after;
+	uint32 size;
+	bool valid; ///< Whether 'after' holds the result of drawing on 'before'
 };
 
+class DrawDataCache {
+public:
+	/** Memory used by all the entries together */
+	static const uint32 kMaxSize = 16 * 1024 * 1024;
+
+	DrawDataCache() : _size(0) {}
+	~DrawDataCache() { clear(); }
+
+	void clear();
+
+	/**
+	 * Copies a cached rasterization of the key into the surface, if the area
+	 * currently holds the same pixels the cached one was drawn on.
+	 */
+	bool draw(const DrawDataCacheKey &key, Graphics::Surface *surface, const Common::Rect &rect);
+
+	/**
+	 * Remembers the pixels of the area before a DrawData is drawn on it.
+	 * Returns nullptr when the area is too large to be cached.
+	 */
+	DrawDataCacheEntry *begin(const DrawDataCacheKey &key, const Graphics::Surface *surface, const Common::Rect &rect);
+
+	/**
+	 * Remembers the pixels of the area after the DrawData has been drawn.
+	 */
+	void end(DrawDataCacheEntry *entry, const Graphics::Surface *surface);
+
+private:
+	typedef Common::HashMap<DrawDataCacheKey, DrawDataCacheEntry *, DrawDataCacheKey_Hash> EntryMap;
+	EntryMap _entries;
+	uint32 _size;
+
+	static void copyArea(Graphics::Surface &dst, const Graphics::Surface *surface, const Common::Rect &rect);
+};
+
+void DrawDataCache::clear() {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		i->_value->before.free();
+		i->_value->after.free();
+		delete i->_value;
+	}
+	_entries.clear();
+	_size = 0;
+}
+
+void DrawDataCache::copyArea(Graphics::Surface &dst, const Graphics::Surface *surface, const Common::Rect &rect) {
+	if (dst.w != rect.width() || dst.h != rect.height() || dst.format != surface->format) {
+		dst.free();
+		dst.create(rect.width(), rect.height(), surface->format);
+	}
+	dst.copyRectToSurface(*surface, 0, 0, rect);
+}
+
+bool DrawDataCache::draw(const DrawDataCacheKey &key, Graphics::Surface *surface, const Common::Rect &rect) {
+	EntryMap::const_iterator i = _entries.find(key);
+	if (i == _entries.end())
+		return false;
+
+	const DrawDataCacheEntry *entry = i->_value;
+	if (!entry->valid || entry->rect != rect)
+		return false;
+
+	const uint rowSize = rect.width() * surface->format.bytesPerPixel;
+	for (int y = 0; y < rect.height(); ++y) {
+		if (memcmp(surface->getBasePtr(rect.left, rect.top + y), entry->before.getBasePtr(0, y), rowSize))
+			return false;
+	}
+
+	surface->copyRectToSurface(entry->after, rect.left, rect.top, Common::Rect(rect.width(), rect.height()));
+	return true;
+}
+
+DrawDataCacheEntry *DrawDataCache::begin(const DrawDataCacheKey &key, const Graphics::Surface *surface, const Common::Rect &rect) {
+	const uint32 size = 2 * rect.width() * rect.height() * surface->format.bytesPerPixel;
+	if (size > kMaxSize / 4)
+		return nullptr;
+
+	DrawDataCacheEntry *entry = nullptr;
+	EntryMap::iterator i = _entries.find(key);
+	if (i != _entries.end()) {
+		entry = i->_value;
+		_size -= entry->size;
+		entry->size = 0;
+	}
+
+	if (_size + size > kMaxSize) {
+		// Start over rather than keeping track of which entries are still
+		// in use, the GUI quickly redraws what it needs again.
+		clear();
+		entry = nullptr;
+	}
+
+	if (!entry) {
+		entry = new DrawDataCacheEntry();
+		_entries[key] = entry;
+	}
+
+	_size += size;
+	entry->size = size;
+	entry->rect = rect;
+	entry->valid = false;
+	copyArea(entry->before, surface, rect);
+
+	return entry;
+}
+
+void DrawDataCache::end(DrawDataCacheEntry *entry, const Graphics::Surface *surface) {
+	copyArea(entry->after, surface, entry->rect);
+	entry->valid = true;
+}
+
 /**********************************************************
  *  Data definitions for theme engine elements
  *********************************************************/
@@ -192,6 +361,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 
 	_system = g_system;
 	_parser = new ThemeParser(this);
+	_drawDataCache = new DrawDataCache();
 	_themeEval = new GUI::ThemeEval();
 
 	_useCursor = false;
@@ -231,6 +401,9 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 }
 
 ThemeEngine::~ThemeEngine() {
+	delete _drawDataCache;
+	_drawDataCache = nullptr;
+
 	delete _vectorRenderer;
 	_vectorRenderer = nullptr;
 	_screen.free();
@@ -458,6 +631,9 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
 
+	// Cached DrawData were rendered for the old surfaces and scale
+	_drawDataCache->clear();
+
 	// Since we reinitialized our screen surfaces we know nothing has been
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
 	// list. Clearing it avoids invalid overlay writes when the backend
@@ -480,6 +656,28 @@ void WidgetDrawData::calcBackgroundOffset() {
 	_shadowOffset = maxShadow;
 }
 
+void WidgetDrawData::calcCacheability() {
+	_cacheable = !_steps.empty();
+	_inheritsColors = false;
+
+	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
+	        step != _steps.end(); ++step) {
+		if (!step->autoWidth || !step->autoHeight ||
+		        step->padding.left < 0 || step->padding.top < 0 ||
+		        step->padding.right < 0 || step->padding.bottom < 0 ||
+		        step->drawingCall == &Graphics::VectorRenderer::drawCallback_TAB ||
+		        step->drawingCall == &Graphics::VectorRenderer::drawCallback_BITMAP ||
+		        step->drawingCall == &Graphics::VectorRenderer::drawCallback_ALPHABITMAP)
+			_cacheable = false;
+	}
+
+	if (_cacheable) {
+		const Graphics::DrawStep &step = _steps.front();
+		_inheritsColors = !step.fgColor.set || !step.bgColor.set || !step.bevelColor.set ||
+		                  !step.gradColor1.set || !step.gradColor2.set;
+	}
+}
+
 void ThemeEngine::restoreBackground(Common::Rect r) {
 	if (_vectorRenderer->getActiveSurface() == &_backBuffer) {
 		// Only restore the background when drawing to the screen surface
@@ -708,6 +906,8 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_layer = kDrawDataDefaults[id].layer;
 	_widgets[id]->_textDataId = kTextDataNone;
+	_widgets[id]->_cacheable = false;
+	_widgets[id]->_inheritsColors = true;
 
 	return true;
 }
@@ -738,6 +938,7 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			warning("Missing data asset: '%s'", kDrawDataDefaults[i].name);
 		} else {
 			_widgets[i]->calcBackgroundOffset();
+			_widgets[i]->calcCacheability();
 		}
 	}
 }
@@ -751,6 +952,8 @@ void ThemeEngine::unloadTheme() {
 		_widgets[i] = nullptr;
 	}
 
+	_drawDataCache->clear();
+
 	for (int i = 0; i < kTextDataMAX; ++i) {
 		delete _texts[i];
 		_texts[i] = nullptr;
@@ -897,15 +1100,106 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+		if (drawData->_cacheable) {
+			drawCachedDD(type, *drawData, area, extendedRect, dynamic);
+		} else {
+			Common::List<Graphics::DrawStep>::const_iterator step;
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+			}
 		}
 
 		addDirtyRect(extendedRect);
 	}
 }
 
+void ThemeEngine::drawCachedDD(DrawData type, const WidgetDrawData &drawData, const Common::Rect &area,
+                               const Common::Rect &extendedRect, uint32 dynamic) {
+	Graphics::TransparentSurface *surface = _vectorRenderer->getActiveSurface();
+
+	// Soft shadows reach a bit further than the dirty rect accounts for
+	Common::Rect cacheRect = extendedRect;
+	cacheRect.grow(drawData._shadowOffset + 2);
+	cacheRect.clip(surface->w, surface->h);
+
+	DrawDataCacheKey key;
+	key.type = type;
+	key.dynamic = dynamic;
+	key.surface = surface;
+	key.area = area;
+	key.clip = _clip;
+	if (drawData._inheritsColors)
+		_vectorRenderer->getColors(key.colors);
+	else
+		memset(key.colors, 0, sizeof(key.colors));
+
+	Common::List<Graphics::DrawStep>::const_iterator step;
+	if (_drawDataCache->draw(key, surface, cacheRect)) {
+		// Leave the renderer in the state drawing the steps would have
+		for (step = drawData._steps.begin(); step != drawData._steps.end(); ++step) {
+			_vectorRenderer->applyStep(area, _clip, *step, dynamic);
+		}
+		return;
+	}
+
+	DrawDataCacheEntry *entry = _drawDataCache->begin(key, surface, cacheRect);
+
+	for (step = drawData._steps.begin(); step != drawData._steps.end(); ++step) {
+		_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+	}
+
+	if (entry)
+		_drawDataCache->end(entry, surface);
+}
+
+uint32 ThemeEngine::benchmarkDrawData(int scale, int iterations) {
+	// Typical widget sizes at 1x
+	static const struct {
+		int w, h;
+	} sizes[] = {
+		{  16,  16 }, // check boxes, radio buttons
+		{ 100,  20 }, // buttons, edit fields, tabs
+		{ 240,  12 }, // sliders, scrollbars
+		{ 320, 200 }  // dialogs, lists
+	};
+
+	if (!_vectorRenderer || scale < 1 || iterations < 1)
+		return 0;
+
+	Graphics::TransparentSurface surface;
+	surface.create(352 * scale, 232 * scale, _overlayFormat);
+
+	Graphics::TransparentSurface *activeSurface = _vectorRenderer->getActiveSurface();
+	_vectorRenderer->setSurface(&surface);
+
+	const Common::Rect clip(surface.w, surface.h);
+	const uint32 start = _system->getMillis();
+
+	for (int i = 0; i < iterations; ++i) {
+		for (int type = 0; type < kDrawDataMAX; ++type) {
+			if (!_widgets[type])
+				continue;
+
+			for (int size = 0; size < ARRAYSIZE(sizes); ++size) {
+				Common::Rect area(sizes[size].w * scale, sizes[size].h * scale);
+				area.translate(16 * scale, 16 * scale);
+
+				Common::List<Graphics::DrawStep>::const_iterator step;
+				for (step = _widgets[type]->_steps.begin(); step != _widgets[type]->_steps.end(); ++step) {
+					_vectorRenderer->drawStep(area, clip, *step);
+				}
+			}
+		}
+	}
+
+	const uint32 elapsed = _system->getMillis() - start;
+
+	_vectorRenderer->setSurface(activeSurface);
+	surface.free();
+
+	return elapsed;
+}
+
 void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::String &text,
                              bool restoreBg, bool ellipsis, Graphics::TextAlign alignH, TextAlignVertical alignV,
                              int deltax, const Common::Rect &drawableTextArea) {
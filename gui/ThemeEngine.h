@@ -49,6 +49,7 @@ class VectorRenderer;
 namespace GUI {
 
 struct WidgetDrawData;
+class DrawDataCache;
 struct TextDrawData;
 struct TextColorData;
 class Dialog;
@@ -613,6 +614,17 @@ public:
 	const Common::String &getThemeId() const { return _themeId; }
 	int getGraphicsMode() const { return _graphicsMode; }
 
+	/**
+	 * Draws every DrawData of the loaded theme at a few typical widget
+	 * sizes, multiplied by the given scale, into an offscreen surface.
+	 * The DrawData cache is bypassed so that only the renderer is measured.
+	 *
+	 * @param scale Factor applied to the widget sizes.
+	 * @param iterations Number of times the whole set is drawn.
+	 * @return Time spent drawing, in milliseconds.
+	 */
+	uint32 benchmarkDrawData(int scale, int iterations);
+
 protected:
 
 	/**
@@ -656,6 +668,8 @@ protected:
 	 * These functions are called from all the Widget drawing methods.
 	 */
 	void drawDD(DrawData type, const Common::Rect &r, uint32 dynamic = 0, bool forceRestore = false);
+	void drawCachedDD(DrawData type, const WidgetDrawData &drawData, const Common::Rect &area,
+	                  const Common::Rect &extendedRect, uint32 dynamic);
 	void drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::String &text, bool restoreBg,
 	                bool elipsis, Graphics::TextAlign alignH = Graphics::kTextAlignLeft,
 	                TextAlignVertical alignV = kTextAlignVTop, int deltax = 0,
@@ -728,6 +742,9 @@ protected:
 	 */
 	WidgetDrawData *_widgets[kDrawDataMAX];
 
+	/** Rasterized DrawData elements, to redraw unchanged widgets quickly. */
+	DrawDataCache *_drawDataCache;
+
 	/** Array of all the text fonts that can be drawn. */
 	TextDrawData *_texts[kTextDataMAX];
 
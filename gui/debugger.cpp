@@ -25,7 +25,9 @@
 
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/fs.h"
 #include "common/system.h"
+#include "common/util.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
@@ -36,7 +38,12 @@
 
 #include "engines/engine.h"
 
+#include "audio/fmopl.h"
+#include "audio/mixer.h"
+
 #include "gui/debugger.h"
+#include "gui/gui-manager.h"
+#include "gui/ThemeEngine.h"
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 	#include "gui/console.h"
 #elif defined(USE_READLINE)
@@ -77,6 +84,9 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+
+	registerCmd("oplbench",			WRAP_METHOD(Debugger, cmdOplBench));
+	registerCmd("themebench",		WRAP_METHOD(Debugger, cmdThemeBench));
 }
 
 Debugger::~Debugger() {
@@ -793,4 +803,100 @@ bool Debugger::debuggerCompletionCallback(GUI::ConsoleDialog *console, const cha
 
 #endif
 
+bool Debugger::cmdOplBench(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("oplbench [seconds | file.dro]\n");
+		debugPrintf("Measures how fast each OPL emulator renders a synthetic AdLib tune,\n");
+		debugPrintf("or a register log captured by DOSBox\n");
+		return true;
+	}
+
+	if (OPL::OPL::hasInstance()) {
+		debugPrintf("An OPL is already in use, quit the game's music first\n");
+		return true;
+	}
+
+	static const struct {
+		OPL::Config::OplType type;
+		uint32 flag;
+		const char *name;
+	} types[] = {
+		{ OPL::Config::kOpl2, OPL::Config::kFlagOpl2, "OPL2" },
+		{ OPL::Config::kDualOpl2, OPL::Config::kFlagDualOpl2, "Dual OPL2" },
+		{ OPL::Config::kOpl3, OPL::Config::kFlagOpl3, "OPL3" }
+	};
+
+	// Either replay the given capture on the chip it was made with, or
+	// a synthetic tune on every chip type
+	OPL::RegisterLog captured;
+	OPL::Config::OplType capturedType = OPL::Config::kOpl2;
+	int seconds = 10;
+
+	if (argc == 2 && !Common::isDigit(argv[1][0])) {
+		Common::FSNode node(argv[1]);
+		Common::SeekableReadStream *stream = node.createReadStream();
+		if (!stream) {
+			debugPrintf("Could not open %s\n", argv[1]);
+			return true;
+		}
+
+		const bool loaded = OPL::Config::loadRegisterLog(*stream, captured, capturedType);
+		delete stream;
+		if (!loaded) {
+			debugPrintf("%s is not a supported DOSBox raw OPL capture\n", argv[1]);
+			return true;
+		}
+	} else if (argc == 2) {
+		seconds = MAX(atoi(argv[1]), 1);
+	}
+
+	for (int i = 0; i < ARRAYSIZE(types); ++i) {
+		if (!captured.empty() && types[i].type != capturedType)
+			continue;
+
+		OPL::RegisterLog synthetic;
+		if (captured.empty())
+			OPL::Config::createTestRegisterLog(types[i].type, seconds * 1000, synthetic);
+		const OPL::RegisterLog &log = captured.empty() ? synthetic : captured;
+
+		for (const OPL::Config::EmulatorDescription *ed = OPL::Config::getAvailable(); ed->name; ++ed) {
+			if (!(ed->flags & types[i].flag))
+				continue;
+
+			uint32 numSamples;
+			const int32 elapsed = OPL::Config::benchmark(ed->id, types[i].type, log, numSamples);
+			if (elapsed < 0)
+				continue;
+
+			const double duration = (double)numSamples / g_system->getMixer()->getOutputRate();
+			debugPrintf("%-8s %-10s %6d ms  %9d samples/s  %5.1fx realtime\n", ed->name, types[i].name, elapsed,
+			            (int)((uint64)numSamples * 1000 / MAX<int32>(elapsed, 1)), duration * 1000.0 / MAX<int32>(elapsed, 1));
+		}
+	}
+	return true;
+}
+
+bool Debugger::cmdThemeBench(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("themebench [iterations]\n");
+		debugPrintf("Measures how fast the active theme's widgets are drawn at 1x, 2x and 3x scale\n");
+		return true;
+	}
+
+	ThemeEngine *theme = g_gui.theme();
+	if (!theme) {
+		debugPrintf("No theme is loaded\n");
+		return true;
+	}
+
+	const int iterations = (argc == 2) ? MAX(atoi(argv[1]), 1) : 20;
+
+	debugPrintf("Drawing the widgets of theme '%s' %d times\n", theme->getThemeId().c_str(), iterations);
+	for (int scale = 1; scale <= 3; ++scale) {
+		const uint32 elapsed = theme->benchmarkDrawData(scale, iterations);
+		debugPrintf("%dx  %6d ms  %8.2f ms/iteration\n", scale, elapsed, (double)elapsed / iterations);
+	}
+	return true;
+}
+
 } // End of namespace GUI